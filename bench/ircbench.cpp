@@ -0,0 +1,815 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ircbench.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:14:52 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 09:14:52 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** ircbench - load generator and latency benchmark for ircserv.
+**
+** Standalone (no server sources), single thread, epoll:
+**   c++ -std=c++98 -O2 -Wall -Wextra -Werror bench/ircbench.cpp -o ircbench
+**
+** 1. connects and registers N clients (at most -w in flight)
+** 2. joins each into -m channels out of -c, drawn uniformly or with a
+**    Zipf distribution (a few big channels, a long tail)
+** 3. sends PRIVMSG to the channels at a total rate of -r per second for
+**    -d seconds; every line carries its send time, so each delivery
+**    gives an end-to-end latency (send → server → every member)
+** 4. waits for the outstanding deliveries, then reports
+**
+** Without channel support in the server (JOIN unknown), or with
+** -M ping, the load is PING :<time> and the latency is the PONG round
+** trip. See docs/Benchmarks.md.
+*/
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <stdexcept>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define READ_CHUNK 16384
+#define MAX_OUTPUT 65536    // per client: past this, sends are skipped
+#define EPOLL_BATCH 256
+
+enum LoadMode
+{
+    MODE_AUTO,
+    MODE_PRIVMSG,
+    MODE_PING
+};
+
+enum Phase
+{
+    PHASE_IDLE,         // not connected yet
+    PHASE_CONNECTING,
+    PHASE_REGISTERING,
+    PHASE_JOINING,
+    PHASE_READY,
+    PHASE_DEAD
+};
+
+struct Options
+{
+    std::string     host;
+    int             port;
+    std::string     password;
+    unsigned int    clients;
+    unsigned int    channels;
+    unsigned int    memberships;
+    bool            zipf;
+    double          rate;
+    double          duration;
+    unsigned int    payload;
+    unsigned int    window;
+    double          setupTimeout;
+    double          drainTimeout;
+    LoadMode        mode;
+    unsigned long   seed;
+
+    Options();
+};
+
+Options::Options()
+    : host("127.0.0.1"), port(6667), password("pw"), clients(100), channels(10),
+    memberships(2), zipf(false), rate(1000), duration(10), payload(32), window(128),
+    setupTimeout(30), drainTimeout(5), mode(MODE_AUTO), seed(1) {}
+
+struct BenchClient
+{
+    int                         fd;
+    unsigned int                index;
+    Phase                       phase;
+    std::string                 nick;
+    std::string                 input;
+    std::string                 output;
+    bool                        wantWrite;
+    std::vector<unsigned int>   planned;    // channels to join
+    std::vector<unsigned int>   joined;     // confirmed by the server
+    size_t                      joinAnswers;
+    unsigned long               connectStart;
+
+    BenchClient();
+};
+
+BenchClient::BenchClient()
+    : fd(-1), index(0), phase(PHASE_IDLE), wantWrite(false), joinAnswers(0),
+    connectStart(0) {}
+
+struct Stats
+{
+    unsigned int                registered;
+    unsigned int                failed;
+    unsigned long               setupStart;
+    unsigned long               setupEnd;
+    std::vector<unsigned long>  registrationNs;
+    size_t                      joinsConfirmed;
+    size_t                      joinsRefused;
+    bool                        joinUnknown;    // 421 on JOIN
+    unsigned long               sent;
+    unsigned long               skipped;        // client output backed up
+    unsigned long               expected;       // deliveries
+    unsigned long               delivered;
+    unsigned long               loadStart;
+    unsigned long               loadEnd;
+    unsigned long               drainEnd;
+    std::vector<unsigned long>  latencyNs;
+
+    Stats();
+};
+
+Stats::Stats()
+    : registered(0), failed(0), setupStart(0), setupEnd(0), joinsConfirmed(0),
+    joinsRefused(0), joinUnknown(false), sent(0), skipped(0), expected(0), delivered(0),
+    loadStart(0), loadEnd(0), drainEnd(0) {}
+
+/*
+** Deterministic generator (xorshift64*), so a seed reproduces the same
+** memberships and send order.
+*/
+class Random
+{
+    private:
+
+    unsigned long   _state;
+
+    public:
+
+    explicit Random(unsigned long seed) : _state(seed ? seed : 0x9E3779B97F4A7C15UL) {}
+
+    unsigned long   next()
+    {
+        _state ^= _state >> 12;
+        _state ^= _state << 25;
+        _state ^= _state >> 27;
+        return (_state * 2685821657736338717UL);
+    }
+
+    double  unit()
+    {
+        return ((next() >> 11) * (1.0 / 9007199254740992.0));
+    }
+};
+
+class Bench
+{
+    private:
+
+    Options                     _options;
+    Stats                       _stats;
+    Random                      _random;
+    std::vector<BenchClient>    _clients;
+    std::vector<unsigned int>   _members;   // confirmed members per channel
+    std::vector<double>         _zipfCdf;
+    int                         _epoll;
+    struct sockaddr_in          _address;
+    unsigned int                _nextConnect;
+    unsigned int                _inFlight;
+    std::string                 _tag;       // nick prefix of this run
+    LoadMode                    _mode;
+
+    Bench(const Bench& other);
+    Bench&  operator=(const Bench& other);
+
+    void    planMemberships();
+    unsigned int    drawChannel();
+    void    startConnections();
+    void    connectClient(BenchClient& client);
+    void    finishSetup(BenchClient& client);
+    void    fail(BenchClient& client);
+    void    queue(BenchClient& client, const std::string& line);
+    void    flush(BenchClient& client);
+    void    updateInterest(BenchClient& client);
+    void    pump(int timeoutMs);
+    void    readClient(BenchClient& client);
+    void    handleLine(BenchClient& client, const std::string& line);
+    void    handleJoinAnswer(BenchClient& client, const std::string& channel, bool ok);
+    void    recordLatency(const std::string& text);
+    void    sendOne(unsigned long now, std::vector<unsigned int>& senders, size_t& cursor);
+    void    report();
+
+    public:
+
+    explicit Bench(const Options& options);
+    ~Bench();
+
+    void    run();
+};
+
+static unsigned long    nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000000UL + ts.tv_nsec);
+}
+
+static std::string  channelName(unsigned int index)
+{
+    std::ostringstream  name;
+
+    name << "#bench" << index;
+    return (name.str());
+}
+
+Bench::Bench(const Options& options)
+    : _options(options), _random(options.seed), _epoll(-1), _nextConnect(0),
+    _inFlight(0), _mode(options.mode)
+{
+    std::memset(&_address, 0, sizeof(_address));
+    _address.sin_family = AF_INET;
+    _address.sin_port = htons(options.port);
+    struct hostent* host = gethostbyname(options.host.c_str());
+    if (host == NULL || host->h_addrtype != AF_INET)
+        throw std::runtime_error("cannot resolve " + options.host);
+    std::memcpy(&_address.sin_addr, host->h_addr_list[0], sizeof(_address.sin_addr));
+
+    _epoll = epoll_create(1024);
+    if (_epoll == -1)
+        throw std::runtime_error("epoll_create failed");
+
+    // nicks: "b" + 2-letter run tag + index in base 36, at most 9 chars
+    static const char*  digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+    unsigned long       stamp = nowNs() / 1000;
+    _tag = std::string("b") + digits[stamp % 36] + digits[(stamp / 36) % 36];
+
+    _clients.resize(options.clients);
+    for (unsigned int i = 0; i < options.clients; i++)
+    {
+        _clients[i].index = i;
+        std::string suffix;
+        for (unsigned int n = i; ; n /= 36)
+        {
+            suffix.insert(suffix.begin(), digits[n % 36]);
+            if (n < 36)
+                break ;
+        }
+        _clients[i].nick = _tag + suffix;
+    }
+    _members.assign(options.channels, 0);
+}
+
+Bench::~Bench()
+{
+    for (size_t i = 0; i < _clients.size(); i++)
+        if (_clients[i].fd != -1)
+            close(_clients[i].fd);
+    if (_epoll != -1)
+        close(_epoll);
+}
+
+/*
+** planMemberships() [PRIVATE]
+** Draws -m distinct channels per client. Zipf (s = 1): channel k is
+** picked with a weight of 1 / (k + 1).
+*/
+void    Bench::planMemberships()
+{
+    unsigned int    channels = _options.channels;
+    unsigned int    count = std::min(_options.memberships, channels);
+
+    if (_options.zipf)
+    {
+        double  total = 0;
+        for (unsigned int k = 0; k < channels; k++)
+        {
+            total += 1.0 / (k + 1);
+            _zipfCdf.push_back(total);
+        }
+        for (unsigned int k = 0; k < channels; k++)
+            _zipfCdf[k] /= total;
+    }
+    for (size_t i = 0; i < _clients.size(); i++)
+    {
+        std::vector<unsigned int>&  planned = _clients[i].planned;
+        while (planned.size() < count)
+        {
+            unsigned int channel = drawChannel();
+            if (std::find(planned.begin(), planned.end(), channel) == planned.end())
+                planned.push_back(channel);
+        }
+    }
+}
+
+unsigned int    Bench::drawChannel()
+{
+    if (!_options.zipf)
+        return (_random.next() % _options.channels);
+    double  u = _random.unit();
+    return (std::lower_bound(_zipfCdf.begin(), _zipfCdf.end(), u) - _zipfCdf.begin());
+}
+
+/*
+** startConnections() [PRIVATE]
+** Opens connections while fewer than -w are connecting or registering,
+** so the listen backlog never overflows into SYN retries.
+*/
+void    Bench::startConnections()
+{
+    while (_nextConnect < _clients.size() && _inFlight < _options.window)
+        connectClient(_clients[_nextConnect++]);
+}
+
+void    Bench::connectClient(BenchClient& client)
+{
+    client.connectStart = nowNs();
+    client.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (client.fd == -1)
+    {
+        client.phase = PHASE_DEAD;
+        _stats.failed++;
+        return ;
+    }
+    int one = 1;
+    setsockopt(client.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(client.fd, (struct sockaddr*)&_address, sizeof(_address)) == -1
+        && errno != EINPROGRESS)
+    {
+        fail(client);
+        return ;
+    }
+    client.phase = PHASE_CONNECTING;
+    _inFlight++;
+
+    struct epoll_event  event;
+    event.events = EPOLLIN | EPOLLOUT;
+    event.data.u32 = client.index;
+    client.wantWrite = true;
+    epoll_ctl(_epoll, EPOLL_CTL_ADD, client.fd, &event);
+
+    queue(client, "PASS " + _options.password);
+    queue(client, "NICK " + client.nick);
+    queue(client, "USER bench 0 * :ircbench");
+}
+
+/*
+** fail(BenchClient& client) [PRIVATE]
+** Drops a client that could not connect or register, or was closed.
+*/
+void    Bench::fail(BenchClient& client)
+{
+    if (client.phase == PHASE_CONNECTING || client.phase == PHASE_REGISTERING
+        || client.phase == PHASE_JOINING)
+        _inFlight--;
+    if (client.phase != PHASE_READY)
+        _stats.failed++;
+    else
+        for (size_t i = 0; i < client.joined.size(); i++)
+            _members[client.joined[i]]--;
+    client.phase = PHASE_DEAD;
+    if (client.fd != -1)
+        close(client.fd);
+    client.fd = -1;
+}
+
+void    Bench::finishSetup(BenchClient& client)
+{
+    client.phase = PHASE_READY;
+    _inFlight--;
+}
+
+void    Bench::queue(BenchClient& client, const std::string& line)
+{
+    client.output += line;
+    client.output += "\r\n";
+}
+
+/*
+** flush(BenchClient& client) [PRIVATE]
+** Writes what the socket takes; the rest waits for EPOLLOUT.
+*/
+void    Bench::flush(BenchClient& client)
+{
+    while (!client.output.empty() && client.phase != PHASE_CONNECTING)
+    {
+        ssize_t written = send(client.fd, client.output.data(), client.output.size(),
+            MSG_NOSIGNAL);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue ;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                fail(client);
+            break ;
+        }
+        client.output.erase(0, written);
+    }
+    if (client.phase != PHASE_DEAD)
+        updateInterest(client);
+}
+
+void    Bench::updateInterest(BenchClient& client)
+{
+    bool want = !client.output.empty() || client.phase == PHASE_CONNECTING;
+    if (want == client.wantWrite)
+        return ;
+
+    struct epoll_event  event;
+    event.events = want ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    event.data.u32 = client.index;
+    epoll_ctl(_epoll, EPOLL_CTL_MOD, client.fd, &event);
+    client.wantWrite = want;
+}
+
+/*
+** pump(int timeoutMs) [PRIVATE]
+** One epoll round: finishes connects, flushes, reads and handles lines.
+*/
+void    Bench::pump(int timeoutMs)
+{
+    struct epoll_event  events[EPOLL_BATCH];
+    int ready = epoll_wait(_epoll, events, EPOLL_BATCH, timeoutMs);
+
+    for (int i = 0; i < ready; i++)
+    {
+        BenchClient& client = _clients[events[i].data.u32];
+        if (client.phase == PHASE_DEAD)
+            continue ;
+        if (client.phase == PHASE_CONNECTING && (events[i].events & (EPOLLOUT | EPOLLERR)))
+        {
+            int         error = 0;
+            socklen_t   length = sizeof(error);
+            getsockopt(client.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            if (error != 0)
+            {
+                fail(client);
+                continue ;
+            }
+            client.phase = PHASE_REGISTERING;
+        }
+        if (events[i].events & EPOLLOUT)
+            flush(client);
+        if (client.phase != PHASE_DEAD && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+            readClient(client);
+    }
+}
+
+void    Bench::readClient(BenchClient& client)
+{
+    char    buffer[READ_CHUNK];
+
+    while (true)
+    {
+        ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received == 0 || (received < 0 && errno != EAGAIN && errno != EINTR))
+        {
+            fail(client);
+            return ;
+        }
+        if (received < 0)
+            break ;
+        client.input.append(buffer, received);
+        if ((size_t)received < sizeof(buffer))
+            break ;
+    }
+
+    size_t  start = 0;
+    size_t  end;
+    while ((end = client.input.find("\r\n", start)) != std::string::npos)
+    {
+        handleLine(client, client.input.substr(start, end - start));
+        if (client.phase == PHASE_DEAD)
+            return ;
+        start = end + 2;
+    }
+    client.input.erase(0, start);
+}
+
+/*
+** handleLine(BenchClient& client, const std::string& line) [PRIVATE]
+** The few replies the benchmark cares about: welcome, JOIN echo or
+** refusal, PING, and the timestamped load coming back.
+*/
+void    Bench::handleLine(BenchClient& client, const std::string& line)
+{
+    std::istringstream  in(line);
+    std::string         source;
+    std::string         command;
+
+    if (!line.empty() && line[0] == ':')
+        in >> source;
+    in >> command;
+    size_t colon = line.find(" :", 1);
+    std::string trailing = (colon == std::string::npos) ? "" : line.substr(colon + 2);
+
+    if (command == "PRIVMSG" || command == "PONG")
+        recordLatency(trailing);
+    else if (command == "PING")
+    {
+        queue(client, "PONG :" + trailing);
+        flush(client);
+    }
+    else if (command == "001" && client.phase == PHASE_REGISTERING)
+    {
+        _stats.registered++;
+        _stats.registrationNs.push_back(nowNs() - client.connectStart);
+        if (client.planned.empty() || _mode == MODE_PING)
+        {
+            finishSetup(client);
+            return ;
+        }
+        std::string join = "JOIN ";
+        for (size_t i = 0; i < client.planned.size(); i++)
+            join += (i ? "," : "") + channelName(client.planned[i]);
+        client.phase = PHASE_JOINING;
+        queue(client, join);
+        flush(client);
+    }
+    else if (command == "JOIN" && client.phase == PHASE_JOINING
+        && source.compare(1, client.nick.size() + 1, client.nick + "!") == 0)
+    {
+        std::string channel;
+        in >> channel;
+        handleJoinAnswer(client, channel[0] == ':' ? channel.substr(1) : channel, true);
+    }
+    else if (client.phase == PHASE_JOINING && command == "421")
+    {
+        _stats.joinUnknown = true;
+        client.joinAnswers = client.planned.size() - 1;
+        handleJoinAnswer(client, "", false);
+    }
+    else if (client.phase == PHASE_JOINING && (command == "403" || command == "405"
+        || command == "471" || command == "473" || command == "474" || command == "475"))
+    {
+        std::string target;
+        std::string channel;
+        in >> target >> channel;
+        handleJoinAnswer(client, channel, false);
+    }
+    else if (command == "433" || command == "464" || command == "ERROR")
+        fail(client);
+}
+
+void    Bench::handleJoinAnswer(BenchClient& client, const std::string& channel, bool ok)
+{
+    if (ok)
+    {
+        for (size_t i = 0; i < client.planned.size(); i++)
+        {
+            if (channelName(client.planned[i]) != channel)
+                continue ;
+            client.joined.push_back(client.planned[i]);
+            _members[client.planned[i]]++;
+            _stats.joinsConfirmed++;
+            break ;
+        }
+    }
+    else
+        _stats.joinsRefused++;
+    if (++client.joinAnswers >= client.planned.size())
+        finishSetup(client);
+}
+
+/*
+** recordLatency(const std::string& text) [PRIVATE]
+** Load lines start with "T<send time in ns>".
+*/
+void    Bench::recordLatency(const std::string& text)
+{
+    if (text.size() < 2 || text[0] != 'T')
+        return ;
+    unsigned long sentAt = std::strtoul(text.c_str() + 1, NULL, 10);
+    unsigned long now = nowNs();
+    if (sentAt == 0 || sentAt > now)
+        return ;
+    _stats.delivered++;
+    _stats.latencyNs.push_back(now - sentAt);
+}
+
+/*
+** sendOne(unsigned long now, std::vector<unsigned int>& senders, size_t& cursor) [PRIVATE]
+** Next load line, senders taken round-robin. A sender whose output is
+** backed up (server not reading) is skipped and the send is counted.
+*/
+void    Bench::sendOne(unsigned long now, std::vector<unsigned int>& senders, size_t& cursor)
+{
+    BenchClient& client = _clients[senders[cursor++ % senders.size()]];
+    if (client.phase != PHASE_READY || client.output.size() > MAX_OUTPUT)
+    {
+        _stats.skipped++;
+        return ;
+    }
+
+    std::ostringstream  line;
+    if (_mode == MODE_PING)
+    {
+        line << "PING :T" << now;
+        _stats.expected++;
+    }
+    else
+    {
+        unsigned int channel = client.joined[_random.next() % client.joined.size()];
+        line << "PRIVMSG " << channelName(channel) << " :T" << now << ' ';
+        _stats.expected += _members[channel] - 1;
+    }
+    line << std::string(_options.payload, 'x');
+    queue(client, line.str());
+    flush(client);
+    _stats.sent++;
+}
+
+void    Bench::run()
+{
+    planMemberships();
+
+    // setup: connect, register, join
+    _stats.setupStart = nowNs();
+    unsigned long deadline = _stats.setupStart + (unsigned long)(_options.setupTimeout * 1e9);
+    startConnections();
+    while ((_nextConnect < _clients.size() || _inFlight > 0) && nowNs() < deadline)
+    {
+        pump(10);
+        startConnections();
+    }
+    _stats.setupEnd = nowNs();
+    for (size_t i = 0; i < _clients.size(); i++)
+        if (_clients[i].phase != PHASE_READY && _clients[i].phase != PHASE_DEAD)
+            fail(_clients[i]);
+
+    if (_mode == MODE_AUTO)
+        _mode = (_stats.joinsConfirmed > 0) ? MODE_PRIVMSG : MODE_PING;
+    std::vector<unsigned int>   senders;
+    for (size_t i = 0; i < _clients.size(); i++)
+        if (_clients[i].phase == PHASE_READY && (_mode == MODE_PING || !_clients[i].joined.empty()))
+            senders.push_back(i);
+
+    // load at a fixed rate
+    _stats.loadStart = nowNs();
+    unsigned long   interval = (unsigned long)(1e9 / _options.rate);
+    unsigned long   end = _stats.loadStart + (unsigned long)(_options.duration * 1e9);
+    unsigned long   next = _stats.loadStart;
+    size_t          cursor = 0;
+    while (!senders.empty())
+    {
+        unsigned long now = nowNs();
+        if (now >= end)
+            break ;
+        for (; next <= now && next < end; next += interval)
+            sendOne(now, senders, cursor);
+        pump(next > now ? std::min((next - now) / 1000000UL, 1UL) : 0);
+    }
+    _stats.loadEnd = nowNs();
+
+    // drain: wait for what is still in flight
+    deadline = _stats.loadEnd + (unsigned long)(_options.drainTimeout * 1e9);
+    while (_stats.delivered < _stats.expected && nowNs() < deadline)
+        pump(10);
+    _stats.drainEnd = nowNs();
+    report();
+}
+
+static double   percentile(const std::vector<unsigned long>& sorted, double p)
+{
+    if (sorted.empty())
+        return (0);
+    size_t index = (size_t)std::ceil(p * sorted.size()) - 1;
+    return (sorted[std::min(index, sorted.size() - 1)] / 1e6);
+}
+
+static double   seconds(unsigned long from, unsigned long to)
+{
+    return ((to - from) / 1e9);
+}
+
+void    Bench::report()
+{
+    std::ostream& out = std::cout;
+    out << std::fixed << std::setprecision(2);
+
+    out << "ircbench " << _options.host << ":" << _options.port << ", "
+        << _options.clients << " clients, " << _options.channels << " channels ("
+        << (_options.zipf ? "zipf" : "uniform") << ", " << _options.memberships
+        << " per client), " << _options.rate << " msg/s for " << _options.duration
+        << " s, mode " << (_mode == MODE_PING ? "ping" : "privmsg") << "\n";
+
+    double setup = seconds(_stats.setupStart, _stats.setupEnd);
+    std::sort(_stats.registrationNs.begin(), _stats.registrationNs.end());
+    out << "setup:    " << _stats.registered << "/" << _options.clients << " registered, "
+        << _stats.failed << " failed, in " << setup << " s ("
+        << (setup > 0 ? _stats.registered / setup : 0) << " clients/s)\n"
+        << "          registration p50 " << percentile(_stats.registrationNs, 0.50)
+        << " ms, p99 " << percentile(_stats.registrationNs, 0.99) << " ms\n";
+    if (_options.channels > 0 && _options.memberships > 0)
+    {
+        out << "joins:    " << _stats.joinsConfirmed << " confirmed, "
+            << _stats.joinsRefused << " refused";
+        if (_stats.joinUnknown)
+            out << " (server does not implement JOIN)";
+        out << "\n";
+    }
+
+    double load = seconds(_stats.loadStart, _stats.loadEnd);
+    double drain = seconds(_stats.loadStart, _stats.drainEnd);
+    out << "load:     sent " << _stats.sent << " (" << (load > 0 ? _stats.sent / load : 0)
+        << " msg/s), skipped " << _stats.skipped << " (backed up)\n"
+        << "delivery: " << _stats.delivered << " of " << _stats.expected << " expected ("
+        << (drain > 0 ? _stats.delivered / drain : 0) << " msg/s), fan-out "
+        << (_stats.sent ? (double)_stats.delivered / _stats.sent : 0) << "x (expected "
+        << (_stats.sent ? (double)_stats.expected / _stats.sent : 0) << "x)\n";
+
+    std::vector<unsigned long>& latency = _stats.latencyNs;
+    std::sort(latency.begin(), latency.end());
+    out << "latency:  p50 " << percentile(latency, 0.50) << " ms, p99 "
+        << percentile(latency, 0.99) << " ms, p999 " << percentile(latency, 0.999)
+        << " ms, max " << (latency.empty() ? 0 : latency.back() / 1e6) << " ms\n";
+}
+
+static void usage()
+{
+    std::cerr << "usage: ircbench [options]\n"
+        "  -h host       server address (127.0.0.1)\n"
+        "  -p port       server port (6667)\n"
+        "  -k password   connection password (pw)\n"
+        "  -n clients    clients to register (100)\n"
+        "  -c channels   channels (10)\n"
+        "  -m count      channels joined per client (2)\n"
+        "  -D dist       membership distribution: uniform | zipf (uniform)\n"
+        "  -r rate       messages per second, all clients together (1000)\n"
+        "  -d seconds    load duration (10)\n"
+        "  -s bytes      payload per message (32)\n"
+        "  -w clients    connections in flight during setup (128)\n"
+        "  -M mode       auto | privmsg | ping (auto: privmsg if JOIN works)\n"
+        "  -S seed       random seed (1)\n";
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    int     opt;
+
+    while ((opt = getopt(argc, argv, "h:p:k:n:c:m:D:r:d:s:w:M:S:")) != -1)
+    {
+        std::string value = (optarg != NULL) ? optarg : "";
+        switch (opt)
+        {
+            case 'h': options.host = value; break ;
+            case 'p': options.port = std::atoi(optarg); break ;
+            case 'k': options.password = value; break ;
+            case 'n': options.clients = std::atoi(optarg); break ;
+            case 'c': options.channels = std::atoi(optarg); break ;
+            case 'm': options.memberships = std::atoi(optarg); break ;
+            case 'D': options.zipf = (value == "zipf"); break ;
+            case 'r': options.rate = std::atof(optarg); break ;
+            case 'd': options.duration = std::atof(optarg); break ;
+            case 's': options.payload = std::atoi(optarg); break ;
+            case 'w': options.window = std::max(1, std::atoi(optarg)); break ;
+            case 'M':
+                options.mode = (value == "ping") ? MODE_PING
+                    : (value == "privmsg") ? MODE_PRIVMSG : MODE_AUTO;
+                break ;
+            case 'S': options.seed = std::strtoul(optarg, NULL, 10); break ;
+            default: usage(); return (1);
+        }
+    }
+    if (options.port <= 0 || options.rate <= 0 || options.payload > 400
+        || (options.channels == 0 && options.mode == MODE_PRIVMSG))
+    {
+        usage();
+        return (1);
+    }
+    if (options.channels == 0)
+        options.memberships = 0;
+
+    // one fd per client
+    struct rlimit   limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < options.clients + 64)
+    {
+        limit.rlim_cur = std::min((rlim_t)options.clients + 64, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    try
+    {
+        Bench bench(options);
+        bench.run();
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "ircbench: " << e.what() << std::endl;
+        return (1);
+    }
+    return (0);
+}
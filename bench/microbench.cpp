@@ -0,0 +1,408 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   microbench.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:02:37 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 11:02:37 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** microbench - repeatable microbenchmarks of the protocol kernels.
+**
+**   c++ -std=c++98 -O2 -Wall -Wextra -Werror -Iinc bench/microbench.cpp \
+**       src/MessageProcessor.cpp src/RingBuffer.cpp -o microbench
+**   ./microbench -o bench/baseline.txt     # record a baseline
+**   ./microbench -b bench/baseline.txt     # compare, exit 1 on regression
+**
+** Each case runs long enough to be timed (-t ms per run), five runs,
+** the fastest one is kept. Allocations are counted by replacing the
+** global operator new, so allocs/op and bytes/op are exact.
+** See docs/Benchmarks.md.
+*/
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <time.h>
+#include <unistd.h>
+#include "MessageProcessor.hpp"
+#include "RingBuffer.hpp"
+
+#define RUNS 5
+#define DEFAULT_RUN_MS 200
+#define DEFAULT_THRESHOLD 10    // % slower than the baseline = regression
+
+/*
+** Allocation accounting: every operator new of the process goes
+** through here. The deletes stay out of line, otherwise GCC pairs the
+** inlined free() with operator new and warns about a mismatch.
+*/
+static unsigned long    g_allocations = 0;
+static unsigned long    g_allocatedBytes = 0;
+
+void*   operator new(std::size_t size) throw(std::bad_alloc)
+{
+    g_allocations++;
+    g_allocatedBytes += size;
+    void* block = std::malloc(size ? size : 1);
+    if (block == NULL)
+        throw std::bad_alloc();
+    return (block);
+}
+
+void*   operator new[](std::size_t size) throw(std::bad_alloc)
+{
+    return (operator new(size));
+}
+
+__attribute__((noinline))
+void    operator delete(void* block) throw()
+{
+    std::free(block);
+}
+
+__attribute__((noinline))
+void    operator delete[](void* block) throw()
+{
+    std::free(block);
+}
+
+static volatile size_t  g_sink;     // results go here, so nothing is optimized out
+
+static unsigned long    nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000000UL + ts.tv_nsec);
+}
+
+/*
+** Line shapes
+*/
+static const std::string    g_short = "NICK alice\r\n";
+static const std::string    g_privmsg = ":alice!alice@127.0.0.1 PRIVMSG #channel :hello there, how is it going\r\n";
+static const std::string    g_mode = "MODE #channel +ooooooooooooo a b c d e f g h i j k l m :n\r\n";
+static const std::string    g_trailing = "PRIVMSG #channel :" + std::string(480, 'x') + "\r\n";
+
+/*
+** One benchmark case: runs op iterations times.
+*/
+typedef void    (*BenchFunction)(size_t iterations);
+
+static void parseViewLine(const std::string& line, size_t iterations)
+{
+    IRCMessageView  view;
+
+    for (size_t i = 0; i < iterations; i++)
+    {
+        MessageProcessor::parseView(line.data(), line.length(), view);
+        g_sink += view.paramCount;
+    }
+}
+
+static void parseLine(const std::string& line, size_t iterations)
+{
+    for (size_t i = 0; i < iterations; i++)
+        g_sink += MessageProcessor::parse(line).params.size();
+}
+
+static void benchParseViewShort(size_t n)     { parseViewLine(g_short, n); }
+static void benchParseViewPrivmsg(size_t n)   { parseViewLine(g_privmsg, n); }
+static void benchParseViewMode(size_t n)      { parseViewLine(g_mode, n); }
+static void benchParseViewTrailing(size_t n)  { parseViewLine(g_trailing, n); }
+static void benchParseShort(size_t n)         { parseLine(g_short, n); }
+static void benchParsePrivmsg(size_t n)       { parseLine(g_privmsg, n); }
+static void benchParseMode(size_t n)          { parseLine(g_mode, n); }
+static void benchParseTrailing(size_t n)      { parseLine(g_trailing, n); }
+
+static void benchBuildNumeric(size_t iterations)
+{
+    const std::string   target = "alice";
+    const std::string   text = "Nickname is already in use";
+
+    for (size_t i = 0; i < iterations; i++)
+        g_sink += MessageProcessor::buildNumericReply(433, target, text).length();
+}
+
+static void benchBuildMessage(size_t iterations)
+{
+    IRCMessage  msg = MessageProcessor::parse(g_privmsg);
+
+    for (size_t i = 0; i < iterations; i++)
+        g_sink += MessageProcessor::buildMessage(msg).length();
+}
+
+/*
+** Framing: the receive ring and its CRLF scan, as NetworkManager runs
+** them after each read (getCompleteLines() / getCompleteMessages() only
+** collect what nextLine() returns). One op = one framed line.
+** - pipelined: 8 lines per read
+** - split: every line arrives in two reads
+** - bytewise: one byte per read, a scan after each
+*/
+static void write(RingBuffer& ring, const char* data, size_t length)
+{
+    struct iovec    iov[2];
+    int             count = ring.getWritableSpans(iov);
+    size_t          done = 0;
+
+    for (int i = 0; i < count && done < length; i++)
+    {
+        size_t chunk = std::min(length - done, iov[i].iov_len);
+        std::memcpy(iov[i].iov_base, data + done, chunk);
+        done += chunk;
+    }
+    ring.commit(done);
+}
+
+static size_t   drain(RingBuffer& ring)
+{
+    const char* line;
+    size_t      length;
+    size_t      lines = 0;
+
+    while (ring.nextLine(line, length))
+    {
+        g_sink += line[0];
+        ring.consume(length);
+        lines++;
+    }
+    return (lines);
+}
+
+static void benchFramePipelined(size_t iterations)
+{
+    RingBuffer  ring;
+    std::string batch;
+
+    for (int i = 0; i < 8; i++)
+        batch += g_privmsg;
+    for (size_t done = 0; done < iterations; )
+    {
+        write(ring, batch.data(), batch.length());
+        done += drain(ring);
+    }
+}
+
+static void benchFrameSplit(size_t iterations)
+{
+    RingBuffer  ring;
+    size_t      half = g_privmsg.length() / 2;
+
+    for (size_t done = 0; done < iterations; )
+    {
+        write(ring, g_privmsg.data(), half);
+        done += drain(ring);
+        write(ring, g_privmsg.data() + half, g_privmsg.length() - half);
+        done += drain(ring);
+    }
+}
+
+static void benchFrameBytewise(size_t iterations)
+{
+    RingBuffer  ring;
+
+    for (size_t done = 0; done < iterations; )
+    {
+        for (size_t i = 0; i < g_privmsg.length(); i++)
+        {
+            write(ring, g_privmsg.data() + i, 1);
+            done += drain(ring);
+        }
+    }
+}
+
+struct BenchCase
+{
+    const char*     name;
+    BenchFunction   function;
+};
+
+static const BenchCase  g_cases[] = {
+    { "parseView/short", benchParseViewShort },
+    { "parseView/privmsg", benchParseViewPrivmsg },
+    { "parseView/mode-15-params", benchParseViewMode },
+    { "parseView/long-trailing", benchParseViewTrailing },
+    { "parse/short", benchParseShort },
+    { "parse/privmsg", benchParsePrivmsg },
+    { "parse/mode-15-params", benchParseMode },
+    { "parse/long-trailing", benchParseTrailing },
+    { "buildNumericReply", benchBuildNumeric },
+    { "buildMessage/privmsg", benchBuildMessage },
+    { "frame/pipelined", benchFramePipelined },
+    { "frame/split", benchFrameSplit },
+    { "frame/bytewise", benchFrameBytewise }
+};
+
+struct Result
+{
+    double  nsPerOp;
+    double  allocsPerOp;
+    double  bytesPerOp;
+};
+
+/*
+** measure(BenchFunction function, unsigned long runMs)
+** Calibrates the iteration count so one run lasts about runMs, then
+** keeps the fastest of RUNS runs (the least disturbed one).
+*/
+static Result   measure(BenchFunction function, unsigned long runMs)
+{
+    size_t          iterations = 64;
+    unsigned long   target = runMs * 1000000UL;
+
+    while (true)
+    {
+        unsigned long start = nowNs();
+        function(iterations);
+        unsigned long elapsed = nowNs() - start;
+        if (elapsed >= target / 4)
+        {
+            iterations = (size_t)((double)iterations * target / elapsed) + 1;
+            break ;
+        }
+        iterations *= 4;
+    }
+
+    Result  best;
+    best.nsPerOp = -1;
+    for (int run = 0; run < RUNS; run++)
+    {
+        unsigned long allocations = g_allocations;
+        unsigned long bytes = g_allocatedBytes;
+        unsigned long start = nowNs();
+        function(iterations);
+        double ns = (double)(nowNs() - start) / iterations;
+        if (best.nsPerOp < 0 || ns < best.nsPerOp)
+        {
+            best.nsPerOp = ns;
+            best.allocsPerOp = (double)(g_allocations - allocations) / iterations;
+            best.bytesPerOp = (double)(g_allocatedBytes - bytes) / iterations;
+        }
+    }
+    return (best);
+}
+
+static std::map<std::string, Result>    loadBaseline(const char* path)
+{
+    std::map<std::string, Result>   baseline;
+    std::ifstream                   in(path);
+    std::string                     line;
+
+    if (!in)
+        throw std::runtime_error(std::string("cannot read ") + path);
+    while (std::getline(in, line))
+    {
+        std::istringstream  fields(line);
+        std::string         name;
+        Result              result;
+
+        if (line.empty() || line[0] == '#')
+            continue ;
+        if (fields >> name >> result.nsPerOp >> result.allocsPerOp >> result.bytesPerOp)
+            baseline[name] = result;
+    }
+    return (baseline);
+}
+
+static void usage()
+{
+    std::cerr << "usage: microbench [-t ms] [-f filter] [-o baseline] [-b baseline] [-T percent]\n"
+        "  -t ms        length of one timed run (" << DEFAULT_RUN_MS << ")\n"
+        "  -f text      only cases whose name contains text\n"
+        "  -o file      save the results as a baseline\n"
+        "  -b file      compare with a saved baseline; exit 1 on regression\n"
+        "  -T percent   slowdown counted as a regression (" << DEFAULT_THRESHOLD << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long   runMs = DEFAULT_RUN_MS;
+    double          threshold = DEFAULT_THRESHOLD;
+    const char*     filter = "";
+    const char*     savePath = NULL;
+    const char*     baselinePath = NULL;
+    int             opt;
+
+    while ((opt = getopt(argc, argv, "t:f:o:b:T:")) != -1)
+    {
+        switch (opt)
+        {
+            case 't': runMs = std::strtoul(optarg, NULL, 10); break ;
+            case 'f': filter = optarg; break ;
+            case 'o': savePath = optarg; break ;
+            case 'b': baselinePath = optarg; break ;
+            case 'T': threshold = std::atof(optarg); break ;
+            default: usage(); return (2);
+        }
+    }
+
+    try
+    {
+        std::map<std::string, Result>   baseline;
+        if (baselinePath != NULL)
+            baseline = loadBaseline(baselinePath);
+
+        std::ostringstream  saved;
+        bool                regression = false;
+        saved << "# name ns/op allocs/op bytes/op\n";
+        std::cout << std::left << std::setw(28) << "case" << std::right
+            << std::setw(12) << "ns/op" << std::setw(12) << "allocs/op"
+            << std::setw(12) << "bytes/op";
+        if (baselinePath != NULL)
+            std::cout << std::setw(12) << "vs base";
+        std::cout << "\n" << std::fixed;
+
+        for (size_t i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); i++)
+        {
+            if (std::strstr(g_cases[i].name, filter) == NULL)
+                continue ;
+            Result result = measure(g_cases[i].function, runMs);
+            std::cout << std::left << std::setw(28) << g_cases[i].name << std::right
+                << std::setprecision(1) << std::setw(12) << result.nsPerOp
+                << std::setprecision(2) << std::setw(12) << result.allocsPerOp
+                << std::setprecision(1) << std::setw(12) << result.bytesPerOp;
+            saved << g_cases[i].name << ' ' << result.nsPerOp << ' '
+                << result.allocsPerOp << ' ' << result.bytesPerOp << '\n';
+
+            std::map<std::string, Result>::iterator base = baseline.find(g_cases[i].name);
+            if (base != baseline.end())
+            {
+                double delta = (result.nsPerOp / base->second.nsPerOp - 1) * 100;
+                bool slower = delta > threshold;
+                bool allocates = result.allocsPerOp > base->second.allocsPerOp + 0.005;
+                std::cout << std::setprecision(1) << std::setw(11) << std::showpos
+                    << delta << '%' << std::noshowpos;
+                if (slower || allocates)
+                    std::cout << "  REGRESSION" << (allocates ? " (allocations)" : "");
+                regression = regression || slower || allocates;
+            }
+            std::cout << std::endl;
+        }
+
+        if (savePath != NULL)
+        {
+            std::ofstream out(savePath);
+            if (!(out << saved.str()))
+                throw std::runtime_error(std::string("cannot write ") + savePath);
+        }
+        return (regression ? 1 : 0);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "microbench: " << e.what() << std::endl;
+        return (2);
+    }
+}
@@ -0,0 +1,424 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipebench.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:20:44 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 15:20:44 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** pipebench - the server pipeline in-process, without TCP.
+**
+**   c++ -std=c++98 -O2 -Wall -Wextra -Werror -pthread -Iinc bench/pipebench.cpp \
+**       <every src/ file but main.cpp> -o pipebench   (docs/Benchmarks.md)
+**   ./pipebench -n 10000 -r 50
+**
+** One Reactor with no listener (Reactor::initializeDetached()) serves
+** -n clients, each the far end of a socketpair(AF_UNIX) it adopted.
+** The harness plays the clients on the same thread and drives the loop
+** one cycle at a time (Reactor::runCycle()), so a run is deterministic:
+** register everyone, then -r rounds where every client sends -l PINGs
+** and the loop turns until every PONG is back and checked.
+** Server time is reported per stage (see CycleTimes), client time apart.
+** See docs/Benchmarks.md.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <stdexcept>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include "IRCServer.hpp"
+
+#define DEFAULT_CLIENTS 1000
+#define DEFAULT_ROUNDS 20
+#define DEFAULT_LINES 1
+#define WATCHDOG_SECONDS 120    // a stuck run is killed, not left hanging
+#define PASSWORD "bench"
+
+struct Options
+{
+    size_t              clients;
+    size_t              rounds;
+    size_t              lines;
+    std::string         backend;
+
+    Options() : clients(DEFAULT_CLIENTS), rounds(DEFAULT_ROUNDS),
+        lines(DEFAULT_LINES), backend("epoll") {}
+};
+
+/*
+** The client end of one socketpair.
+*/
+struct Peer
+{
+    int         fd;
+    std::string input;      // partial line carried over
+    size_t      expected;   // PONGs still due this round
+    bool        registered;
+};
+
+/*
+** Client side of the run: writes the load, reads and checks the
+** replies. Its time is kept out of the server stages.
+*/
+class Clients
+{
+    private:
+
+    std::vector<Peer>       _peers;
+    int                     _epollFd;
+    std::vector<struct epoll_event> _events;
+    size_t                  _registered;
+    size_t                  _outstanding;
+    size_t                  _errors;
+    std::string             _token;
+    std::vector<char>       _buffer;
+
+    Clients(const Clients& other);
+    Clients&    operator=(const Clients& other);
+
+    void    handleLine(Peer& peer, const std::string& line)
+    {
+        std::istringstream  fields(line);
+        std::string         source;
+        std::string         command;
+
+        fields >> source >> command;
+        if (command == "001" && !peer.registered)
+        {
+            peer.registered = true;
+            _registered++;
+        }
+        else if (command == "PONG" && peer.expected > 0)
+        {
+            if (line.size() < _token.size()
+                || line.compare(line.size() - _token.size(), _token.size(), _token) != 0)
+                _errors++;
+            peer.expected--;
+            _outstanding--;
+        }
+        else if (command == "ERROR")
+            _errors++;
+    }
+
+    void    readPeer(Peer& peer)
+    {
+        while (true)
+        {
+            ssize_t count = read(peer.fd, &_buffer[0], _buffer.size());
+            if (count <= 0)
+            {
+                if (count == 0 || (errno != EAGAIN && errno != EINTR))
+                    throw std::runtime_error("server closed a connection");
+                if (errno == EAGAIN)
+                    return ;
+                continue ;
+            }
+            peer.input.append(&_buffer[0], count);
+            size_t start = 0;
+            size_t end;
+            while ((end = peer.input.find("\r\n", start)) != std::string::npos)
+            {
+                handleLine(peer, peer.input.substr(start, end - start));
+                start = end + 2;
+            }
+            peer.input.erase(0, start);
+        }
+    }
+
+    static void writeAll(int fd, const std::string& data)
+    {
+        size_t done = 0;
+
+        while (done < data.size())
+        {
+            ssize_t count = write(fd, data.data() + done, data.size() - done);
+            if (count < 0 && errno == EINTR)
+                continue ;
+            if (count < 0 && errno == EAGAIN)
+                throw std::runtime_error("client socket buffer full: lower -l");
+            if (count < 0)
+                throw std::runtime_error(std::string("client write: ") + strerror(errno));
+            done += count;
+        }
+    }
+
+    public:
+
+    Clients() : _epollFd(epoll_create1(EPOLL_CLOEXEC)), _registered(0), _outstanding(0),
+        _errors(0), _buffer(65536)
+    {
+        if (_epollFd == -1)
+            throw std::runtime_error("epoll_create1 failed");
+    }
+
+    ~Clients()
+    {
+        for (size_t i = 0; i < _peers.size(); i++)
+            close(_peers[i].fd);
+        close(_epollFd);
+    }
+
+    /*
+    ** connect(Reactor& reactor, size_t count)
+    ** count socketpairs: the server end goes to the reactor, the other
+    ** one stays here, watched for replies. Both are non-blocking: a
+    ** round must fit in the socket buffer, the loop only turns between
+    ** writes.
+    */
+    void    connect(Reactor& reactor, size_t count)
+    {
+        _peers.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            int                 pair[2];
+            struct epoll_event  event;
+
+            if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, pair) == -1)
+                throw std::runtime_error(std::string("socketpair: ") + strerror(errno));
+            reactor.adoptSocket(pair[0]);
+            Peer peer;
+            peer.fd = pair[1];
+            peer.expected = 0;
+            peer.registered = false;
+            _peers.push_back(peer);
+            std::memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN;
+            event.data.u32 = i;
+            if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, pair[1], &event) == -1)
+                throw std::runtime_error(std::string("epoll_ctl: ") + strerror(errno));
+        }
+        _events.resize(std::min(count, (size_t)4096));
+    }
+
+    void    sendRegistration()
+    {
+        for (size_t i = 0; i < _peers.size(); i++)
+        {
+            std::ostringstream  lines;
+            lines << "PASS " PASSWORD "\r\nNICK p" << i << "\r\nUSER p" << i
+                << " 0 * :pipebench\r\n";
+            writeAll(_peers[i].fd, lines.str());
+        }
+    }
+
+    /*
+    ** sendRound(size_t round, size_t lines)
+    ** Every client sends lines PINGs; each PONG must echo the round.
+    */
+    void    sendRound(size_t round, size_t lines)
+    {
+        std::ostringstream  token;
+        std::string         batch;
+
+        token << "r" << round;
+        _token = token.str();
+        for (size_t i = 0; i < lines; i++)
+            batch += "PING :" + _token + "\r\n";
+        for (size_t i = 0; i < _peers.size(); i++)
+        {
+            writeAll(_peers[i].fd, batch);
+            _peers[i].expected = lines;
+        }
+        _outstanding = _peers.size() * lines;
+    }
+
+    /*
+    ** receive()
+    ** Reads whatever the server sent since the last call.
+    */
+    void    receive()
+    {
+        while (true)
+        {
+            int ready = epoll_wait(_epollFd, &_events[0], _events.size(), 0);
+            if (ready == -1 && errno == EINTR)
+                continue ;
+            if (ready <= 0)
+                return ;
+            for (int i = 0; i < ready; i++)
+                readPeer(_peers[_events[i].data.u32]);
+            if ((size_t)ready < _events.size())
+                return ;
+        }
+    }
+
+    size_t  getRegistered() const   { return (_registered); }
+    size_t  getOutstanding() const  { return (_outstanding); }
+    size_t  getErrors() const       { return (_errors); }
+    size_t  size() const            { return (_peers.size()); }
+};
+
+static unsigned long    nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000000UL + ts.tv_nsec);
+}
+
+/*
+** reserveDescriptors(size_t clients)
+** Two fds per client plus the server's own: raises the soft limit up to
+** the hard one, or fails with the count that would be needed.
+*/
+static void reserveDescriptors(size_t clients)
+{
+    struct rlimit   limit;
+    rlim_t          needed = clients * 2 + 64;
+
+    if (getrlimit(RLIMIT_NOFILE, &limit) == -1)
+        throw std::runtime_error("getrlimit failed");
+    if (limit.rlim_cur >= needed)
+        return ;
+    if (limit.rlim_max != RLIM_INFINITY && limit.rlim_max < needed)
+    {
+        std::ostringstream  error;
+        error << clients << " clients need " << needed << " fds, the hard limit is "
+            << limit.rlim_max << " (ulimit -Hn)";
+        throw std::runtime_error(error.str());
+    }
+    limit.rlim_cur = needed;
+    if (setrlimit(RLIMIT_NOFILE, &limit) == -1)
+        throw std::runtime_error("setrlimit failed");
+}
+
+static void printStage(const char* name, unsigned long ns, unsigned long total,
+    unsigned long lines)
+{
+    std::cout << "  " << std::left << std::setw(10) << name << std::right
+        << std::setw(10) << std::setprecision(2) << ns / 1e6 << " ms"
+        << std::setw(10) << std::setprecision(1) << (lines ? (double)ns / lines : 0.0)
+        << " ns/line" << std::setw(8) << (total ? 100.0 * ns / total : 0.0) << " %\n";
+}
+
+static void report(const char* phase, const CycleTimes& times, unsigned long clientNs,
+    unsigned long wallNs)
+{
+    unsigned long server = times.poll + times.frame + times.parse + times.execute + times.other;
+
+    std::cout << std::fixed << phase << ": " << times.lines << " lines in "
+        << times.cycles << " cycles, " << std::setprecision(1) << wallNs / 1e6 << " ms"
+        << " (server " << server / 1e6 << " ms, "
+        << std::setprecision(0) << (server ? times.lines * 1e9 / server : 0.0)
+        << " lines/s)\n";
+    printStage("poll", times.poll, server, times.lines);
+    printStage("frame", times.frame, server, times.lines);
+    printStage("parse", times.parse, server, times.lines);
+    printStage("execute", times.execute, server, times.lines);
+    printStage("other", times.other, server, times.lines);
+    std::cout << "  " << std::left << std::setw(10) << "clients" << std::right
+        << std::setw(10) << std::setprecision(2) << clientNs / 1e6
+        << " ms (writing the load, reading and checking the replies)\n";
+}
+
+static void usage()
+{
+    std::cerr << "usage: pipebench [-n clients] [-r rounds] [-l lines] [-b backend]\n"
+        "  -n clients   socketpair clients (" << DEFAULT_CLIENTS << ")\n"
+        "  -r rounds    load rounds, every client in each (" << DEFAULT_ROUNDS << ")\n"
+        "  -l lines     PINGs per client per round (" << DEFAULT_LINES << ")\n"
+        "  -b backend   epoll, poll or uring (epoll)\n";
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    int     opt;
+
+    while ((opt = getopt(argc, argv, "n:r:l:b:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n': options.clients = std::strtoul(optarg, NULL, 10); break ;
+            case 'r': options.rounds = std::strtoul(optarg, NULL, 10); break ;
+            case 'l': options.lines = std::strtoul(optarg, NULL, 10); break ;
+            case 'b': options.backend = optarg; break ;
+            default: usage(); return (2);
+        }
+    }
+    if (options.clients == 0 || options.lines == 0)
+    {
+        usage();
+        return (2);
+    }
+
+    try
+    {
+        reserveDescriptors(options.clients);
+        signal(SIGPIPE, SIG_IGN);
+        alarm(WATCHDOG_SECONDS);
+
+        IRCServer   server(6667, PASSWORD);     // no listener: the port is unused
+        server.setFloodControl(false);
+        server.setEventBackend(options.backend);
+        Reactor     reactor(server, 0);
+        reactor.initializeDetached(options.backend == "poll" ? EVENT_BACKEND_POLL
+            : options.backend == "epoll" ? EVENT_BACKEND_EPOLL : EVENT_BACKEND_URING);
+        Clients     clients;
+
+        CycleTimes      registration;
+        unsigned long   clientNs = 0;
+        unsigned long   start = nowNs();
+
+        clients.connect(reactor, options.clients);
+        clients.sendRegistration();
+        clientNs += nowNs() - start;
+        while (clients.getRegistered() < clients.size())
+        {
+            reactor.runCycle(&registration);
+            unsigned long mark = nowNs();
+            clients.receive();
+            clientNs += nowNs() - mark;
+        }
+        report("registration", registration, clientNs, nowNs() - start);
+
+        CycleTimes  load;
+        clientNs = 0;
+        start = nowNs();
+        for (size_t round = 0; round < options.rounds; round++)
+        {
+            unsigned long mark = nowNs();
+            clients.sendRound(round, options.lines);
+            clientNs += nowNs() - mark;
+            while (clients.getOutstanding() > 0)
+            {
+                reactor.runCycle(&load);
+                mark = nowNs();
+                clients.receive();
+                clientNs += nowNs() - mark;
+            }
+        }
+        if (options.rounds > 0)
+            report("load", load, clientNs, nowNs() - start);
+
+        if (clients.getErrors() != 0)
+        {
+            std::cout << "FAILED: " << clients.getErrors() << " unexpected replies\n";
+            return (1);
+        }
+        std::cout << "OK: " << clients.size() << " clients, "
+            << options.rounds * options.lines * clients.size() << " PONGs checked\n";
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "pipebench: " << e.what() << std::endl;
+        return (2);
+    }
+    return (0);
+}
@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AtomTable.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:08:33 by odana             #+#    #+#             */
+/*   Updated: 2026/10/18 15:08:33 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ATOM_TABLE_HPP
+# define ATOM_TABLE_HPP
+
+# include <string>
+# include <vector>
+# include <deque>
+
+# define ATOM_TABLE_MIN_CAPACITY 256  // power of two
+
+typedef unsigned int    Atom;
+
+# define NO_ATOM 0  // the empty string
+
+/*
+** Interned identifiers (nicknames, channel names, hostnames): each
+** distinct string is stored once and named by a small integer. Two
+** atoms are the same string iff their ids are equal; two names are the
+** same under RFC 1459 casemapping iff their folded() atoms are equal.
+**
+** Atoms are reference counted: intern() and retain() take a reference,
+** release() drops it and frees the entry (and its id) on the last one.
+** An atom keeps a reference on its folded atom, unless already folded.
+** Entries never move: text() references stay valid while the atom lives.
+*/
+class AtomTable
+{
+    private:
+
+    struct Entry
+    {
+        std::string     text;
+        Atom            folded;
+        unsigned int    hash;
+        unsigned int    refs;
+    };
+
+    struct Slot
+    {
+        unsigned int    hash;
+        Atom            atom;   // NO_ATOM: free slot
+    };
+
+    std::deque<Entry>   _entries;   // indexed by atom, [NO_ATOM] is ""
+    std::vector<Atom>   _freeAtoms;
+    std::vector<Slot>   _slots;
+    size_t              _count;
+
+    AtomTable();
+    AtomTable(const AtomTable& other);
+    AtomTable&  operator=(const AtomTable& other);
+
+    size_t  findSlot(const char* text, size_t length, unsigned int hash) const;
+    void    eraseSlot(Atom atom);
+    void    growSlots();
+
+    public:
+
+    static AtomTable&   instance();
+
+    Atom                intern(const char* text, size_t length);
+    Atom                intern(const std::string& text);
+    Atom                find(const char* text, size_t length) const;
+    Atom                find(const std::string& text) const;
+    void                retain(Atom atom);
+    void                release(Atom atom);
+
+    const std::string&  text(Atom atom) const;
+    unsigned int        hash(Atom atom) const;
+    Atom                folded(Atom atom) const;
+    bool                sameName(Atom a, Atom b) const;
+    size_t              size() const;
+};
+
+#endif
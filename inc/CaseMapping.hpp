@@ -0,0 +1,35 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CaseMapping.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:40:15 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 18:40:15 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CASE_MAPPING_HPP
+# define CASE_MAPPING_HPP
+
+# include <string>
+# include <cstddef>
+
+/*
+** RFC 1459 casemapping: A-Z and [\]^ fold to a-z and {|}~, so
+** "Nick[a]" and "nick{A}" are the same nickname. Everything that
+** compares nicknames or channel names goes through here.
+*/
+class CaseMapping
+{
+    public:
+
+    static unsigned char    toLower(unsigned char c);
+    static void             fold(const char* src, size_t length, char* dst);
+    static std::string      fold(const std::string& name);
+    static bool             equals(const char* a, const char* b, size_t length);
+    static unsigned int     hash(const char* folded, size_t length);
+};
+
+#endif
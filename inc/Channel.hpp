@@ -13,6 +13,92 @@
 #ifndef CHANNEL_HPP
 # define CHANNEL_HPP
 
-// TODO @yitani
+# include <string>
+# include <vector>
+# include "Handles.hpp"
+# include "AtomTable.hpp"
+# include "NetworkManager.hpp"
+# include "SharedBuffer.hpp"
 
-#endif 
\ No newline at end of file
+# define CHANNELLEN 50  // RFC 2812
+
+enum MemberFlags
+{
+    MEMBER_JOINED = 1 << 0,
+    MEMBER_OP = 1 << 1,
+    MEMBER_VOICE = 1 << 2,
+    MEMBER_INVITED = 1 << 3     // invited, may be set before joining
+};
+
+enum ChannelModes
+{
+    CHANMODE_INVITE_ONLY = 1 << 0,  // i
+    CHANMODE_TOPIC_OPS = 1 << 1,    // t
+    CHANMODE_KEY = 1 << 2,          // k
+    CHANMODE_LIMIT = 1 << 3         // l
+};
+
+struct Member
+{
+    ClientHandle    client;
+    int             fd;         // where fan-out sends, -1 for an invite
+    unsigned int    flags;
+};
+
+/*
+** One channel. Members are a dense vector of (client handle, fd, flag
+** bits): fan-out and op/voice/invite checks are a linear scan over a
+** few bytes per member, no string lookups. An entry with only
+** MEMBER_INVITED is a pending invite, not a member.
+*/
+class Channel
+{
+    private:
+
+    ChannelHandle       _handle;
+    Atom                _name;
+    std::string         _topic;
+    std::string         _key;
+    size_t              _userLimit;
+    unsigned int        _modes;
+    std::vector<Member> _members;
+    size_t              _joinedCount;
+
+    Channel(const Channel& other);
+    Channel&    operator=(const Channel& other);
+
+    Member*     findMember(ClientHandle client);
+
+    public:
+
+    Channel(ChannelHandle handle, const std::string& name);
+    ~Channel();
+
+    ChannelHandle       getHandle() const;
+    const std::string&  getName() const;
+    const std::string&  getFoldedName() const;
+    Atom                getNameAtom() const;
+    const std::string&  getTopic() const;
+    const std::string&  getKey() const;
+    size_t              getUserLimit() const;
+    size_t              getMemberCount() const;
+    const std::vector<Member>&  getMembers() const;
+
+    void    setTopic(const std::string& topic);
+    void    setKey(const std::string& key);
+    void    setUserLimit(size_t limit);
+    bool    hasMode(ChannelModes mode) const;
+    void    setMode(ChannelModes mode, bool enabled);
+
+    bool    addMember(ClientHandle client, int fd, unsigned int flags);
+    bool    removeMember(ClientHandle client);
+    bool    isMember(ClientHandle client);
+    bool    hasFlag(ClientHandle client, MemberFlags flag);
+    void    setFlag(ClientHandle client, MemberFlags flag, bool enabled);
+    void    invite(ClientHandle client);
+
+    void    broadcast(NetworkManager& networkManager, const SharedBuffer& line,
+                ClientHandle except);
+};
+
+#endif
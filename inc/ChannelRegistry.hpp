@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChannelRegistry.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 11:12:05 by odana             #+#    #+#             */
+/*   Updated: 2026/10/18 11:12:05 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CHANNEL_REGISTRY_HPP
+# define CHANNEL_REGISTRY_HPP
+
+# include <string>
+# include <vector>
+# include "Handles.hpp"
+# include "Channel.hpp"
+# include "Client.hpp"
+# include "AtomTable.hpp"
+
+# define CHANNEL_TABLE_MIN_CAPACITY 64  // power of two
+
+/*
+** Every channel, by handle and by name. The registry owns the Channel
+** objects.
+**
+** - by handle: a vector of Channel*, freed handles are reused
+** - by name: an open-addressing hash table (linear probing, at most
+**   half full) of (hash, handle) keyed on the atom of the RFC 1459
+**   folded name; a probe compares cached hashes, then atoms
+*/
+class ChannelRegistry
+{
+    private:
+
+    struct NameSlot
+    {
+        unsigned int    hash;
+        ChannelHandle   handle;     // INVALID_CHANNEL: free slot
+    };
+
+    std::vector<Channel*>       _channels;
+    std::vector<ChannelHandle>  _freeHandles;
+    std::vector<NameSlot>       _nameSlots;
+    size_t                      _channelCount;
+
+    ChannelRegistry(const ChannelRegistry& other);
+    ChannelRegistry&    operator=(const ChannelRegistry& other);
+
+    size_t  findSlot(Atom folded) const;
+    void    eraseName(const Channel& channel);
+    void    growNameTable();
+
+    public:
+
+    ChannelRegistry();
+    ~ChannelRegistry();
+
+    Channel*    createChannel(const std::string& name, Client* creator);
+    Channel*    getChannel(const std::string& name);
+    Channel*    getChannel(ChannelHandle handle);
+    void        removeChannel(ChannelHandle handle);
+    void        removeUserFromAll(Client* client);
+    size_t      getChannelCount() const;
+};
+
+#endif
@@ -14,7 +14,12 @@
 # define CLIENT_HPP
 
 # include <string>
-# include <set>
+# include <vector>
+# include "Handles.hpp"
+# include "AtomTable.hpp"
+# include "TimerWheel.hpp"
+
+# define NICKLEN 9  // RFC 1459
 
 enum ClientState
 {
@@ -28,24 +33,43 @@ class Client
     private:
     
     int         _fd;
+    ClientHandle    _handle;
     std::string _username;
-    std::string _nickname;
+    Atom        _nickname;
     std::string _realname;
-    std::string _hostname;
+    Atom        _hostname;
+    std::string _prefix;    // nick!user@host, re-rendered on change
     
     ClientState _state;
     bool        _paswordVerified;
     bool        _isOperator;
     
+    std::vector<ChannelHandle>  _channels;
+
+    TimerId         _timer;         // registration / keepalive deadline
+    unsigned long   _lastActivity;  // ms, last line received
+    unsigned long   _pingSentAt;    // ms, 0 when no PING is outstanding
+
+    Client(const Client& other);
+    Client& operator=(const Client& other);
+
+    void    renderPrefix();
+    
     public:
     
+    Client(int fd, ClientHandle handle);
+    ~Client();
+    
     int         getFd() const;
+    ClientHandle    getHandle() const;
     ClientState getState() const;
 
     const std::string&  getNickname() const;
     const std::string&  getUsername() const;
     const std::string&  getRealname() const;
     const std::string&  getHostname() const;
+    Atom                getNicknameAtom() const;
+    Atom                getHostnameAtom() const;
     
     bool    isPasswordVerified() const;
     bool    isOperator() const;
@@ -58,12 +82,21 @@ class Client
     void    setPasswordVerified(bool verified);
     void    setOperator(bool isOp);
     
-    void    joinChannel(const std::string& channelName);
-    void    leaveChannel(const std::string& channelName);
-    bool    isInChannel(const std::string& channelName);
-    const std::set<std::string>& getChannels() const;
+    void    joinChannel(ChannelHandle channel);
+    void    leaveChannel(ChannelHandle channel);
+    void    leaveAllChannels();
+    bool    isInChannel(ChannelHandle channel) const;
+    const std::vector<ChannelHandle>&   getChannels() const;
     
-    std::string getPrefix() const;
+    const std::string&  getPrefix() const;
+    const std::string&  getReplyTarget() const;
+
+    TimerId         getTimer() const;
+    unsigned long   getLastActivity() const;
+    unsigned long   getPingSentAt() const;
+    void            setTimer(TimerId timer);
+    void            setLastActivity(unsigned long now);
+    void            setPingSentAt(unsigned long now);
     
     // ... getters and setters?
 };
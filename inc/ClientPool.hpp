@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ClientPool.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:10:37 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 22:10:37 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CLIENT_POOL_HPP
+# define CLIENT_POOL_HPP
+
+# include <vector>
+# include <cstddef>
+# include "Handles.hpp"
+
+class Client;
+
+# define CLIENT_SLAB_SIZE 256   // Client objects per slab
+
+/*
+** Slab allocator for Client objects, addressed by generational handle.
+** - storage comes in slabs of CLIENT_SLAB_SIZE objects that are never
+**   given back: a connect/disconnect storm reuses slots, no malloc
+** - create() / destroy() / get() are O(1)
+** - destroy() bumps the slot's generation, so every handle to the old
+**   client stops resolving (get() returns NULL) even once the slot, or
+**   the client's fd, has been reused
+** - free slots are reused oldest first, which spreads the generation
+**   bumps over all slots and delays a wrap-around (12 bits) as long as
+**   possible
+*/
+class ClientPool
+{
+    private:
+
+    struct Slot
+    {
+        unsigned int    generation; // never 0
+        unsigned int    nextFree;   // free list link, CLIENT_INDEX_MASK = end
+        bool            live;
+    };
+
+    std::vector<char*>  _slabs;
+    std::vector<Slot>   _slots;
+    unsigned int        _freeHead;
+    unsigned int        _freeTail;
+    size_t              _live;
+
+    ClientPool(const ClientPool& other);
+    ClientPool& operator=(const ClientPool& other);
+
+    Client* slot(unsigned int index);
+    bool    grow();
+
+    public:
+
+    ClientPool();
+    ~ClientPool();
+
+    ClientHandle    create(int fd);
+    void            destroy(ClientHandle handle);
+    Client*         get(ClientHandle handle);
+    size_t          size() const;
+};
+
+#endif
@@ -13,6 +13,46 @@
 #ifndef COMMAND_ENGINE_HPP
 # define COMMAND_ENGINE_HPP
 
-// TODO @yitani
+# include <map>
+# include <string>
+# include "ICommand.hpp"
+# include "CommandId.hpp"
+# include "Client.hpp"
+# include "MessageProcessor.hpp"
+# include "NetworkManager.hpp"
+
+/*
+** Routes parsed messages to their ICommand handler.
+** Handlers are owned by the engine once registered. Built-in commands
+** live in a fixed array indexed by CommandId; names outside that set
+** can still be registered at runtime and go to a map.
+*/
+class CommandEngine
+{
+    private:
+
+    ICommand*                           _handlers[CMD_COUNT];
+    std::map<std::string, ICommand*>    _extraHandlers;
+    NetworkManager&                     _networkManager;
+    Metrics&                            _metrics;
+
+    CommandEngine(const CommandEngine& other);
+    CommandEngine&  operator=(const CommandEngine& other);
+
+    ICommand*   findHandler(const StringSlice& command, CommandId& id);
+    ICommand*   resolve(Client* client, const StringSlice& command, CommandId& id);
+
+    public:
+
+    static CommandId    lookup(const char* name, size_t length);
+    static const char*  name(CommandId id);
+
+    CommandEngine(NetworkManager& networkManager);
+    ~CommandEngine();
+
+    void    registerCommand(const std::string& name, ICommand* handler);
+    void    execute(Client* client, const IRCMessage& message);
+    void    execute(Client* client, const IRCMessageView& message);
+};
 
 #endif
\ No newline at end of file
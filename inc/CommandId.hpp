@@ -0,0 +1,45 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CommandId.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:42:09 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 17:42:09 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef COMMAND_ID_HPP
+# define COMMAND_ID_HPP
+
+/*
+** Commands the server knows at build time. They resolve through a
+** switch on (length, first letter) instead of a string lookup; see
+** CommandEngine::lookup(). Also the index of the per-command metrics.
+*/
+enum CommandId
+{
+    CMD_PASS,
+    CMD_NICK,
+    CMD_USER,
+    CMD_QUIT,
+    CMD_PING,
+    CMD_PONG,
+    CMD_JOIN,
+    CMD_PART,
+    CMD_KICK,
+    CMD_INVITE,
+    CMD_TOPIC,
+    CMD_MODE,
+    CMD_PRIVMSG,
+    CMD_NOTICE,
+    CMD_NAMES,
+    CMD_LIST,
+    CMD_WHO,
+    CMD_STATS,
+    CMD_COUNT,
+    CMD_UNKNOWN = CMD_COUNT
+};
+
+#endif
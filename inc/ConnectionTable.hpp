@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConnectionTable.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:20:05 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 11:20:05 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CONNECTION_TABLE_HPP
+# define CONNECTION_TABLE_HPP
+
+# include <vector>
+# include <deque>
+# include <string>
+# include <stdint.h>
+# include "RingBuffer.hpp"
+# include "SharedBuffer.hpp"
+
+# define CONNECTION_TABLE_MIN 64    // initial capacity, records
+
+/*
+** Everything NetworkManager knows about one socket, kept in one record
+** so a lookup touches a single cache line neighbourhood.
+*/
+struct Connection
+{
+    int                     fd;
+    uint32_t                peerAddr;   // IPv4, network order
+    bool                    wantWrite;  // write interest armed in backend
+    bool                    closing;    // queued for cleanup this cycle
+    bool                    dirty;      // received bytes since last framing
+    bool                    readPending;// stopped reading with data left
+    bool                    discarding; // dropping the rest of an over-long line
+    bool                    throttled;  // complete lines held back by flood control
+    bool                    floodExempt;
+    unsigned int            floodTokens;
+    unsigned long           floodStamp; // ms timestamp of the last token refill
+    RingBuffer              readBuffer;
+    std::deque<SharedBuffer>    writeQueue;
+    size_t                  writeOffset;// bytes of writeQueue.front() sent
+    size_t                  sendQBytes; // unsent bytes across writeQueue
+    unsigned long           queuedAt;   // ns, writeQueue went non-empty
+    bool                    sendInFlight;// completion backend: send submitted
+    std::string             overflow;   // completion backend: received, ring full
+
+    Connection();
+    void    swap(Connection& other);
+};
+
+/*
+** Dense array of live connections plus an fd -> slot index.
+** find() is O(1), remove() swaps the last record into the hole (O(1)),
+** and iteration walks only live connections. Records are never copied:
+** the array grows by swapping them into a larger one (see grow()).
+*/
+class ConnectionTable
+{
+    private:
+
+    std::vector<Connection> _connections;
+    std::vector<int>        _slotByFd;
+
+    void    grow();
+
+    public:
+
+    ConnectionTable();
+    ~ConnectionTable();
+
+    Connection* add(int fd);
+    Connection* find(int fd);
+    void        remove(int fd);
+    
+    size_t      size() const;
+    Connection& at(size_t slot);
+};
+
+#endif
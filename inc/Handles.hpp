@@ -0,0 +1,34 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Handles.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:05:12 by odana             #+#    #+#             */
+/*   Updated: 2026/10/18 10:05:12 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HANDLES_HPP
+# define HANDLES_HPP
+
+/*
+** Small integer handles the registries use to refer to each other's
+** objects instead of names or pointers.
+** - ClientHandle: slot index in the ClientPool (low CLIENT_INDEX_BITS)
+**   and the slot's generation (high bits). A handle outlives its client
+**   safely: once the client is gone it no longer resolves, even if the
+**   slot or the fd was reused. 0 is never a live handle.
+** - ChannelHandle: index in ChannelRegistry
+*/
+typedef unsigned int    ClientHandle;
+typedef unsigned int    ChannelHandle;
+
+# define CLIENT_INDEX_BITS 20
+# define CLIENT_INDEX_MASK ((1u << CLIENT_INDEX_BITS) - 1)
+# define CLIENT_GENERATION_MASK ((1u << (32 - CLIENT_INDEX_BITS)) - 1)
+# define INVALID_CLIENT ((ClientHandle)0)
+# define INVALID_CHANNEL ((ChannelHandle)-1)
+
+#endif
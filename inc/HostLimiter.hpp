@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HostLimiter.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 21:04:12 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 21:04:12 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HOST_LIMITER_HPP
+# define HOST_LIMITER_HPP
+
+# include <vector>
+# include <cstddef>
+# include <stdint.h>
+
+# define HOST_MAX_CONNECTIONS 16    // concurrent connections per address
+# define HOST_CONNECT_BURST 8       // connection attempts before throttling
+# define HOST_CONNECT_REFILL_MS 2000// then one attempt per period
+# define HOST_TABLE_MIN 64          // initial slots, power of two
+
+enum HostVerdict
+{
+    HOST_ADMIT,
+    HOST_TOO_MANY,      // HOST_MAX_CONNECTIONS already open
+    HOST_TOO_FAST       // connect rate exceeded
+};
+
+/*
+** Per-address connection accounting: concurrent connections plus a
+** token bucket of connection attempts (the flood control of
+** NetworkManager, applied to accept()).
+** - owned either by one event loop (its NetworkManager) or by a
+**   ShardGroup, whose single instance every reactor goes through under
+**   the group's _hostLock. NetworkManager::setHostLimits() must run
+**   after attachShardGroup() for the shared table to get the limits
+** - open addressing with linear probing over a power-of-two table of
+**   16-byte entries, keyed by the IPv4 address; no allocation per
+**   connection once the table has grown
+** - entries of hosts without connections and with a full bucket are
+**   forgotten when the table grows, so a scan of many addresses does
+**   not pin memory
+** - loopback (127.0.0.0/8) is never limited: local bots, benchmarks
+*/
+class HostLimiter
+{
+    private:
+
+    struct Entry
+    {
+        uint32_t        addr;       // network order, 0 = empty slot
+        uint16_t        active;
+        uint16_t        tokens;
+        unsigned long   stamp;      // ms timestamp of the last refill
+    };
+
+    std::vector<Entry>  _table;
+    unsigned int        _bits;      // log2(_table.size())
+    size_t              _used;
+    unsigned int        _maxActive;
+    unsigned int        _burst;
+    unsigned long       _refillMs;
+
+    Entry*  find(uint32_t addr);
+    Entry*  insert(uint32_t addr, unsigned long nowMs);
+    void    refill(Entry& entry, unsigned long nowMs) const;
+    void    grow(unsigned long nowMs);
+    size_t  slotOf(uint32_t addr) const;
+
+    public:
+
+    HostLimiter();
+
+    HostVerdict admit(uint32_t addr, unsigned long nowMs);
+    void        release(uint32_t addr);
+    void        setLimits(unsigned int maxActive, unsigned int burst,
+                    unsigned long refillMs);
+    unsigned int    getActive(uint32_t addr);
+    size_t      size() const;
+
+    static bool isExempt(uint32_t addr);
+};
+
+#endif
@@ -23,6 +23,13 @@ class ICommand
     virtual ~ICommand() {}
     virtual void execute(Client* client, const IRCMessage& msg) = 0;
     virtual bool requiresAuth() const = 0;
+
+    // hot-path entry point: override to work on the slices directly,
+    // the default builds an owning IRCMessage
+    virtual void executeView(Client* client, const IRCMessageView& msg)
+    {
+        execute(client, msg.toMessage());
+    }
     
 };
 
@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   IEventBackend.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:02:11 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 10:02:11 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef IEVENT_BACKEND_HPP
+# define IEVENT_BACKEND_HPP
+
+# include <vector>
+# include <cstddef>
+# include "SharedBuffer.hpp"
+
+enum EventFlags
+{
+    EVENT_READ  = 1 << 0,   // data (or a pending connection) to read
+    EVENT_WRITE = 1 << 1,   // socket can take more output
+    EVENT_ERROR = 1 << 2,   // hangup or socket error, fd must be dropped
+    EVENT_ACCEPT = 1 << 3,  // completion: fd is a new, non-blocking client
+    EVENT_DATA  = 1 << 4,   // completion: data/length were received on fd
+    EVENT_SENT  = 1 << 5    // completion: length bytes of the send went out
+};
+
+enum EventBackendType
+{
+    EVENT_BACKEND_DEFAULT,  // epoll on Linux, poll everywhere else
+    EVENT_BACKEND_POLL,
+    EVENT_BACKEND_EPOLL,
+    EVENT_BACKEND_URING     // io_uring, epoll if the kernel lacks it
+};
+
+/*
+** data, length and buffer are only meaningful for completion events
+** (EVENT_DATA, EVENT_SENT), readiness backends leave them alone.
+*/
+struct IOEvent
+{
+    int         fd;
+    int         flags;
+    const char* data;
+    size_t      length;
+    int         buffer;     // backend buffer id, see releaseBuffer()
+};
+
+/*
+** Readiness notification interface used by NetworkManager.
+** wait() only reports fds that actually have events, so the caller's
+** dispatch loop scales with ready fds instead of connected fds.
+** Backends may be edge-triggered: callers must drain reads, writes and
+** accepts until EAGAIN.
+**
+** A completion backend (completesIO() true) performs socket I/O itself:
+** addListener() accepts, addConnection() receives, and wait() reports
+** the results (EVENT_ACCEPT, EVENT_DATA, EVENT_SENT) instead of
+** readiness. Output is handed over with submitSend(), one send in
+** flight per fd; received data stays valid until releaseBuffer().
+** The defaults below make a readiness backend ignore all of this.
+*/
+class IEventBackend
+{
+    public:
+
+    virtual ~IEventBackend() {}
+    virtual void    addFd(int fd) = 0;
+    virtual void    removeFd(int fd) = 0;
+    virtual void    setWriteInterest(int fd, bool enabled) = 0;
+    virtual int     wait(std::vector<IOEvent>& events, int timeoutMs) = 0;
+    virtual const char* getName() const = 0;
+
+    virtual bool    completesIO() const { return (false); }
+    virtual void    addListener(int fd) { addFd(fd); }
+    virtual void    addConnection(int fd) { addFd(fd); }
+    virtual void    setReadInterest(int fd, bool enabled) { (void)fd; (void)enabled; }
+    virtual void    releaseBuffer(const IOEvent& event) { (void)event; }
+    virtual bool    submitSend(int fd, const SharedBuffer* parts, size_t count, size_t offset)
+    {
+        (void)fd; (void)parts; (void)count; (void)offset;
+        return (false);
+    }
+
+    static IEventBackend*   create(EventBackendType type);
+};
+
+#endif
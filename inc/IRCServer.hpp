@@ -14,13 +14,27 @@
 # define IRC_SERVER_HPP
 
 # include <string>
+# include <vector>
 # include <stdexcept>
 # include <csignal>
 # include <cstdlib>
-# include "NetworkManager.hpp"
-# include "MessageProcessor.hpp"
-# include "CommandEngine.hpp"
+# include <pthread.h>
+# include <ctime>
+# include "UserRegistry.hpp"
+# include "ChannelRegistry.hpp"
+# include "ShardGroup.hpp"
+# include "Reactor.hpp"
+# include "Metrics.hpp"
+# include "MetricsEndpoint.hpp"
 
+# define MOTD_PATH "ircd.motd"
+# define MAX_REACTORS 64
+
+/*
+** Owns the shared IRC state (registries) and the event loops.
+** One Reactor on the main thread by default; setReactorCount(n) before
+** initialize() runs n of them sharded over threads (see Reactor).
+*/
 class IRCServer
 {
     private:
@@ -33,24 +47,49 @@ class IRCServer
     IRCServer(int port, const std::string password);
     ~IRCServer();
     
+    void    setReactorCount(unsigned int count);
+    void    setEventBackend(const std::string& name);
+    void    setFloodControl(bool enabled);
+    void    setMetricsSocket(const std::string& path);
     void    initialize();
     void    run();
     void    shutdown();
 
     static void signalHandler(int sig);
 
+    bool                isRunning() const;
+    unsigned int        getMotdGeneration() const;
+    unsigned int        getTraceGeneration() const;
+    bool                isFloodControlEnabled() const;
+    unsigned long       getUptime() const;
+    void                collectMetrics(Metrics& total);
+    const std::string&  getPassword() const;
+    UserRegistry&       getUserRegistry();
+    ChannelRegistry&    getChannelRegistry();
+    void                lockState();
+    void                unlockState();
+
     private:
 
-    const int           _port;
-    const std::string   _password;
-    static IRCServer*   _instance;
-    bool    _running;
+    const int               _port;
+    const std::string       _password;
+    static IRCServer*       _instance;
+    bool                    _running;           // atomic access only
+    unsigned int            _motdGeneration;    // atomic access only
+    unsigned int            _traceGeneration;   // atomic access only
+    unsigned int            _reactorCount;
+    EventBackendType        _backend;
+    bool                    _floodControl;
+    const std::time_t       _startTime;
+    MetricsEndpoint*        _metricsEndpoint;   // NULL unless configured
+    pthread_mutex_t         _stateLock;
 
-    NetworkManager  _networkManager;
-    // UserRegistry    _userRegistry; // TODO @yitani
-    // ChannelRegistry _channelRegistry; // TODO @yitani
-    // CommandEngine   _commandEngine; // TODO @yitani
-    
+    UserRegistry            _userRegistry;
+    ChannelRegistry         _channelRegistry;
+    ShardGroup*             _shards;
+    std::vector<Reactor*>   _reactors;
+
+    void    wakeReactors();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,44 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ISendQPolicy.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 16:40:11 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 16:40:11 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ISENDQ_POLICY_HPP
+# define ISENDQ_POLICY_HPP
+
+# include <cstddef>
+
+enum SendPriority
+{
+    SEND_NORMAL,    // replies, channel traffic: never silently dropped
+    SEND_LOW        // informational noise that may be shed under pressure
+};
+
+enum SendQAction
+{
+    SENDQ_DROP,         // discard this message, keep the client
+    SENDQ_DISCONNECT    // close the client (Max SendQ exceeded)
+};
+
+/*
+** Decides what happens when a message would push a client's queued
+** output past its SendQ budget. Implemented by the IRC layer so the
+** network layer stays protocol-agnostic.
+*/
+class ISendQPolicy
+{
+    public:
+
+    virtual ~ISendQPolicy() {}
+    virtual SendQAction onSendQExceeded(int fd, size_t queuedBytes,
+        size_t messageBytes, SendPriority priority) = 0;
+};
+
+#endif
@@ -15,8 +15,12 @@
 
 # include <string>
 # include <vector>
-# include <iomanip>
-# include <sstream>
+
+# define MAX_PARAMS 15   // RFC 2812: 14 middle params + trailing
+# define SERVER_NAME "ircserv"
+# define SERVER_VERSION "ft_irc-1.0"
+# define SERVER_PREFIX ":" SERVER_NAME " "
+# define SERVER_PREFIX_LENGTH (sizeof(SERVER_PREFIX) - 1)
 
 struct IRCMessage
 {
@@ -28,15 +32,56 @@ struct IRCMessage
     IRCMessage();
 };
 
+/*
+** Non-owning pointer/length slice of a line buffer.
+*/
+struct StringSlice
+{
+    const char* data;
+    size_t      length;
+
+    StringSlice();
+    StringSlice(const char* data, size_t length);
+    
+    bool        empty() const;
+    bool        equals(const char* literal) const;
+    std::string str() const;
+};
+
+/*
+** Parsed view of one line: every field points into the caller's buffer
+** (typically the connection's receive ring), params are a fixed inline
+** array. Nothing is allocated; the view is only valid as long as the
+** buffer is. toMessage() makes an owning IRCMessage for code that keeps
+** messages around; the reverse constructor views an IRCMessage, so
+** commands only implement executeView().
+*/
+struct IRCMessageView
+{
+    StringSlice prefix;
+    StringSlice command;
+    StringSlice params[MAX_PARAMS];
+    size_t      paramCount;
+    StringSlice trailing;
+    bool        hasTrailing;
+
+    IRCMessageView();
+    explicit IRCMessageView(const IRCMessage& message);
+    IRCMessage  toMessage() const;
+};
+
 class MessageProcessor
 {
 public:
     static IRCMessage parse(const std::string& rawMessage);
+    static bool parseView(const char* data, size_t length, IRCMessageView& view);
     
     static std::string buildNumericReply(int code, const std::string& target, 
         const std::string& message);
     
     static std::string buildMessage(const IRCMessage& message);
+
+    static const char*  numericCode(int code);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Metrics.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:51:33 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 17:51:33 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef METRICS_HPP
+# define METRICS_HPP
+
+# include <string>
+# include <cstddef>
+# include <time.h>
+# include "CommandId.hpp"
+
+# define HISTOGRAM_SUB_BITS 3       // 8 buckets per power of two: <= 12.5% error
+# define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+# define HISTOGRAM_MAX_EXPONENT 42  // 2^42 ns, about 73 minutes, larger is clamped
+# define HISTOGRAM_BUCKETS (HISTOGRAM_SUB_BUCKETS * (HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BITS + 2))
+
+/*
+** Single-writer counter: only the owning event loop updates it, any
+** thread may read it. Relaxed atomic loads and stores compile to plain
+** moves, so the hot path takes no lock and no locked instruction; a
+** reader may see a slightly stale value, never a torn one.
+*/
+inline void counterAdd(unsigned long& counter, unsigned long amount)
+{
+    __atomic_store_n(&counter, __atomic_load_n(&counter, __ATOMIC_RELAXED) + amount,
+        __ATOMIC_RELAXED);
+}
+
+inline void counterSub(unsigned long& counter, unsigned long amount)
+{
+    __atomic_store_n(&counter, __atomic_load_n(&counter, __ATOMIC_RELAXED) - amount,
+        __ATOMIC_RELAXED);
+}
+
+inline void counterSet(unsigned long& counter, unsigned long value)
+{
+    __atomic_store_n(&counter, value, __ATOMIC_RELAXED);
+}
+
+inline unsigned long    counterGet(const unsigned long& counter)
+{
+    return (__atomic_load_n(&counter, __ATOMIC_RELAXED));
+}
+
+/*
+** Log-linear latency histogram (ns), HdrHistogram style: values below
+** HISTOGRAM_SUB_BUCKETS have a bucket each, then every power of two is
+** split into HISTOGRAM_SUB_BUCKETS linear buckets. record() is a few
+** shifts and four relaxed stores; quantiles come back within 12.5%.
+** Written by one thread (see counterAdd()).
+*/
+class LatencyHistogram
+{
+    private:
+
+    unsigned long   _buckets[HISTOGRAM_BUCKETS];
+    unsigned long   _count;
+    unsigned long   _sum;
+    unsigned long   _max;
+
+    static size_t           bucketOf(unsigned long value);
+    static unsigned long    upperBound(size_t bucket);
+
+    public:
+
+    LatencyHistogram();
+
+    void            record(unsigned long ns);
+    void            mergeInto(LatencyHistogram& total) const;
+    unsigned long   getCount() const;
+    unsigned long   getSum() const;
+    unsigned long   getMax() const;
+    unsigned long   quantile(double q) const;
+};
+
+/*
+** Runtime metrics of one event loop, owned by its NetworkManager and
+** updated by that loop only (NetworkManager, CommandEngine, Reactor);
+** IRCServer::collectMetrics() sums every loop's into a snapshot for
+** STATS and the scrape endpoint. Counters are totals since start,
+** connections and sendQBytes are current values.
+*/
+struct Metrics
+{
+    unsigned long       loopIterations;
+    unsigned long       bytesIn;
+    unsigned long       bytesOut;
+    unsigned long       linesIn;        // framed
+    unsigned long       parseErrors;
+    unsigned long       connectionsAccepted;
+    unsigned long       connectionsClosed;
+    unsigned long       connections;
+    unsigned long       sendQBytes;     // queued output, every connection
+    unsigned long       commands[CMD_COUNT + 1];    // CMD_UNKNOWN: others
+    LatencyHistogram    loopTime;       // wait return → end of dispatch
+    LatencyHistogram    commandTime[CMD_COUNT + 1];
+    LatencyHistogram    sendDelay;      // output queued → fully sent
+
+    Metrics();
+
+    void    mergeInto(Metrics& total) const;
+    std::string render(unsigned long uptime) const;
+
+    static unsigned long    clock();
+};
+
+/*
+** clock()
+** Monotonic time in ns, for the latency histograms.
+*/
+inline unsigned long    Metrics::clock()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000000UL + ts.tv_nsec);
+}
+
+#endif
@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MetricsEndpoint.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:48:20 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 19:48:20 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef METRICS_ENDPOINT_HPP
+# define METRICS_ENDPOINT_HPP
+
+# include <string>
+# include <pthread.h>
+
+# define METRICS_SEND_TIMEOUT_S 1   // a scraper that does not read is dropped
+
+class IRCServer;
+
+/*
+** Plaintext scrape endpoint on a local (AF_UNIX) socket, away from the
+** IRC port: every connection gets one snapshot of the metrics in
+** Prometheus text format (Metrics::render()), then is closed.
+**   socat - UNIX-CONNECT:/run/ircserv.metrics
+**
+** It runs on its own thread, blocked in poll() between scrapes, and
+** reads the loops' counters without locks (see Metrics): serving a
+** scrape costs the event loops nothing. stop() wakes it through a
+** self-pipe.
+*/
+class MetricsEndpoint
+{
+    private:
+
+    IRCServer&      _server;
+    std::string     _path;
+    int             _socket;
+    int             _wakePipe[2];
+    pthread_t       _thread;
+    bool            _running;
+
+    MetricsEndpoint(const MetricsEndpoint& other);
+    MetricsEndpoint&    operator=(const MetricsEndpoint& other);
+
+    static void*    threadMain(void* endpoint);
+    void    serve();
+    void    respond(int fd);
+    void    closeAll();
+
+    public:
+
+    MetricsEndpoint(IRCServer& server, const std::string& path);
+    ~MetricsEndpoint();
+
+    void    start();
+    void    stop();
+};
+
+#endif
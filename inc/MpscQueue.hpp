@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MpscQueue.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 09:12:40 by odana             #+#    #+#             */
+/*   Updated: 2026/10/19 09:12:40 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MPSC_QUEUE_HPP
+# define MPSC_QUEUE_HPP
+
+# include <cstddef>
+
+/*
+** Lock-free multi-producer, single-consumer queue of intrusive nodes
+** (T must have a T* next member).
+**
+** Producers push with a CAS on the head (a Treiber stack). The consumer
+** detaches the whole stack at once with an atomic exchange and reverses
+** it, so nodes come out in push order per producer. No node is ever
+** popped individually, hence no ABA problem.
+*/
+template <typename T>
+class MpscQueue
+{
+    private:
+
+    T*  _head;
+
+    MpscQueue(const MpscQueue& other);
+    MpscQueue&  operator=(const MpscQueue& other);
+
+    public:
+
+    MpscQueue() : _head(NULL) {}
+
+    /*
+    ** push(T* node)
+    ** Any thread.
+    */
+    void    push(T* node)
+    {
+        T*  head = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+
+        do
+            node->next = head;
+        while (!__atomic_compare_exchange_n(&_head, &head, node, true,
+                    __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+
+    /*
+    ** takeAll()
+    ** Consumer thread only.
+    **
+    ** Returns: every queued node, oldest first, linked through next
+    */
+    T*  takeAll()
+    {
+        T*  node = __atomic_exchange_n(&_head, static_cast<T*>(NULL), __ATOMIC_ACQUIRE);
+        T*  ordered = NULL;
+
+        while (node != NULL)
+        {
+            T* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+        return (ordered);
+    }
+};
+
+#endif
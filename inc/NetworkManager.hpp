@@ -14,49 +14,164 @@
 # define NETWORK_MANAGER_HPP
 
 # include <vector>
-# include <map>
-# include <queue>
 # include <string>
 # include <utility>
+# include <sys/uio.h>       // readv, iovec
+# include <cstring>         // memset
 # include <sys/socket.h>    // socket, bind, listen, setsockopt
 # include <netinet/in.h>    // sockaddr_in, INADDR_ANY
 # include <arpa/inet.h>     // htons, inet_addr
 # include <fcntl.h>         // fcntl, O_NONBLOCK
 # include <unistd.h>        // close
-# include <poll.h>          // pollfd, POLLIN
+# include <time.h>          // clock_gettime
+# include <algorithm>
 # include <stdexcept>
 # include <errno.h>
+# include <limits.h>        // IOV_MAX
+# include "IEventBackend.hpp"
+# include "ConnectionTable.hpp"
+# include "ISendQPolicy.hpp"
+# include "ShardGroup.hpp"
+# include "TimerWheel.hpp"
+# include "HostLimiter.hpp"
+# include "Metrics.hpp"
+# include "Trace.hpp"
+
+# define WRITE_BATCH 64             // iovecs gathered per sendmsg()
+# define ACCEPT_BATCH 64            // connections accepted per cycle
+# define ACCEPT_RETRY_MS 100        // accept4() out of fds → retry after
+# define READ_BUDGET 4096           // bytes read per socket per cycle
+# define OUTPUT_CHUNK_SIZE 4096     // coalesced output block
+# define MAX_LINE_LENGTH 512        // RFC 1459, \r\n included
+# define FLOOD_BURST 5              // RFC 1459: 10 s window / 2 s per line
+# define FLOOD_REFILL_MS 2000
+# define DEFAULT_SENDQ_LIMIT 524288 // queued output bytes per client
+
+/*
+** One complete line (\r\n included) pointing into a connection's
+** receive ring. Valid until the next pollEvents() call.
+*/
+struct LineView
+{
+    int         fd;
+    const char* data;
+    size_t      length;
+};
 
 class NetworkManager
 {
     private:
 
         int _serverSocket;
-        std::vector<struct pollfd>  _pollFds;
-        std::map<int, std::string>  _readBuffers;
-        std::map<int, std::queue<std::string> > _writeQueues;
+        IEventBackend*              _backend;
+        std::vector<IOEvent>        _events;
+        ConnectionTable             _connections;
         std::vector<int> _newConnections;
+        std::vector<int> _adoptedConnections;  // adoptSocket() between cycles
         std::vector<int> _disconnectedClients;
+        std::vector<int> _pendingRemovals;
+        std::vector<int> _deferredCloses;  // closed next cycle
+        std::vector<int> _dirtyConnections;
+        std::vector<int> _pendingReads;
+        std::vector<LineView> _lines;
+        std::vector<int>      _throttledConnections;
+        size_t                _sendQLimit;
+        ISendQPolicy*         _sendQPolicy;
+        unsigned int          _floodBurst;
+        unsigned long         _floodRefillMs;
+        unsigned long         _now;
+        unsigned long         _cycleStart;  // ns, when this cycle's wait returned
+        TimerWheel            _timers;
+        std::vector<unsigned int> _expiredTimers;
+        char                  _replyScratch[MAX_LINE_LENGTH];
+        ShardGroup*           _shards;
+        unsigned int          _shardId;
+        bool                  _completion;  // backend performs the I/O
+        std::vector<int>      _sendReady;
+        std::vector<SharedBuffer> _sendBatch;
+        HostLimiter           _hostLimits;
+        bool                  _acceptPending;   // ACCEPT_BATCH reached
+        unsigned long         _acceptRetryAt;   // ms, 0 = no retry armed
+        Metrics               _metrics;
+
+        NetworkManager(const NetworkManager& other);
+        NetworkManager& operator=(const NetworkManager& other);
     
     public: 
         NetworkManager();
         ~NetworkManager();
         
-        void    initialize(int port);
+        void    initialize(int port, EventBackendType backend = EVENT_BACKEND_DEFAULT);
+        void    initializeDetached(EventBackendType backend = EVENT_BACKEND_DEFAULT);
+        void    adoptSocket(int fd);
         void    pollEvents();
-        void    sendMessage(int clientFd, const std::string& message);
+        void    sendMessage(int clientFd, const std::string& message,
+                    SendPriority priority = SEND_NORMAL);
+        void    sendMessage(int clientFd, const SharedBuffer& message,
+                    SendPriority priority = SEND_NORMAL);
+        char*   beginReply(int clientFd);
+        void    commitReply(int clientFd, size_t length,
+                    SendPriority priority = SEND_NORMAL);
+        void    sendGather(int clientFd, const struct iovec* parts, size_t count,
+                    SendPriority priority = SEND_NORMAL);
+        void    sendFinal(int clientFd, const std::string& message);
         void    removeClient(int fd);
         bool    isValidSocket(int fd);
-        std::vector<int>    getNewClients();
-        std::vector<int>    getDisconnectedClients();
+        const std::vector<int>& getNewClients() const;
+        const std::vector<int>& getDisconnectedClients() const;
         std::vector<std::pair<int, std::string> > getCompleteMessages();
+        const std::vector<LineView>& getCompleteLines();
+        const std::vector<unsigned int>&    getExpiredTimers() const;
+        TimerWheel&         getTimers();
+        unsigned long       getTime() const;
+        unsigned long       getCycleStart() const;
+        Metrics&            getMetrics();
+        const char* getBackendName() const;
+        std::string getPeerHost(int fd);
+
+        void    setSendQLimit(size_t bytes);
+        void    setSendQPolicy(ISendQPolicy* policy);
+        size_t  getSendQLimit() const;
+        size_t  getSendQueueBytes(int fd);
+        size_t  getSendQueueLength(int fd);
+
+        void    setFloodControl(unsigned int burst, unsigned long refillMs);
+        void    setFloodExempt(int fd, bool exempt);
+        void    setHostLimits(unsigned int maxPerHost, unsigned int burst,
+                    unsigned long refillMs);
+        void    attachShardGroup(ShardGroup* group, unsigned int shard);
 
     private:
+        void    createBackend(EventBackendType backend);
         void    handleNewConnection();
-        void    handleClientEvent(size_t index);
-        void    handleIncomingData(size_t index);
-        void    handleOutgoingData(size_t index);
+        void    acceptCompleted(int clientFd);
+        void    admitConnection(int clientFd, uint32_t peerAddr);
+        void    refuseConnection(int clientFd, uint32_t peerAddr, const char* reason);
+        void    adoptConnection(int clientFd, uint32_t peerAddr);
+        void    handleClientEvent(const IOEvent& event);
+        void    handleIncomingData(Connection& conn);
+        void    handleOutgoingData(Connection& conn);
+        void    receiveCompleted(Connection& conn, const char* data, size_t length);
+        size_t  storeReceived(Connection& conn, const char* data, size_t length);
+        void    resumeReceive(Connection& conn);
+        void    submitSends();
+        void    sendCompleted(Connection& conn, size_t sent);
+        void    popSent(Connection& conn, size_t sent);
+        void    markDisconnected(Connection& conn);
+        ssize_t sendDirect(Connection& conn, const char* data, size_t length);
+        bool    admitToSendQ(Connection& conn, size_t bytes, SendPriority priority);
+        void    sendShared(Connection& conn, const SharedBuffer& message, SendPriority priority);
+        void    enqueue(Connection& conn, const SharedBuffer& message, size_t written);
+        void    enqueueCopy(Connection& conn, const char* data, size_t length);
+        void    armWrite(Connection& conn);
+        void    resumePendingReads();
+        void    frameLines(Connection& conn);
+        bool    takeFloodToken(Connection& conn);
+        int     computeTimeout();
+        static unsigned long    monotonicMs();
         void    cleanupDisconnectedClients();
+        void    closeDeferred();
+        void    receiveForwarded();
     };
 
 # endif
\ No newline at end of file
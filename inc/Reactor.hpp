@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Reactor.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:05:26 by odana             #+#    #+#             */
+/*   Updated: 2026/10/19 13:05:26 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REACTOR_HPP
+# define REACTOR_HPP
+
+# include <string>
+# include <vector>
+# include <pthread.h>
+# include "NetworkManager.hpp"
+# include "ISendQPolicy.hpp"
+# include "CommandEngine.hpp"
+# include "RegistrationBurst.hpp"
+# include "ShardGroup.hpp"
+
+# define REGISTRATION_TIMEOUT_MS 60000  // to complete PASS/NICK/USER
+# define PING_INTERVAL_MS 120000        // idle time before a keepalive PING
+# define PING_TIMEOUT_MS 60000          // then, time left to answer it
+
+class IRCServer;
+
+/*
+** Time spent in each stage of the loop (ns, summed over cycles), filled
+** in by runCycle() on request. sendMessage() writes straight to the
+** socket when nothing is queued, so most output is part of execute;
+** queued output, and every send of a completion backend, is flushed in
+** poll.
+*/
+struct CycleTimes
+{
+    unsigned long   cycles;
+    unsigned long   lines;
+    unsigned long   poll;       // pollEvents(): wait, reads, queued output
+    unsigned long   frame;      // getCompleteLines()
+    unsigned long   parse;      // parseView()
+    unsigned long   execute;    // command handlers and their replies
+    unsigned long   other;      // connects, timeouts, disconnects
+
+    CycleTimes();
+};
+
+/*
+** A line of the cycle, parsed outside the state lock. The view points
+** into the receive ring, like the LineView it comes from.
+*/
+struct ParsedLine
+{
+    int             fd;
+    bool            valid;      // parseView() succeeded
+    IRCMessageView  view;
+};
+
+/*
+** One event loop: a NetworkManager with its own connections, and the
+** per-loop IRC pieces that send through it (command handlers, the
+** registration burst, SendQ policy).
+**
+** By default the server runs a single Reactor on the main thread. In
+** multi-reactor mode each Reactor is a shard of a ShardGroup with its
+** own thread and SO_REUSEPORT listener; reading, framing and output
+** stay on the shard, parsing too, the IRC state (registries) is shared
+** under IRCServer's state lock.
+*/
+class Reactor : public ISendQPolicy
+{
+    private:
+
+    IRCServer&                  _server;
+    const unsigned int          _id;
+    NetworkManager              _networkManager;
+    CommandEngine               _commandEngine;
+    RegistrationBurst           _registrationBurst;
+    std::vector<ClientHandle>   _clientsByFd;   // this loop's connections
+    std::vector<ParsedLine>     _parsed;        // reused, never shrunk
+    unsigned int                _motdGeneration;
+    unsigned int                _traceGeneration;
+    pthread_t                   _thread;
+
+    Reactor(const Reactor& other);
+    Reactor&    operator=(const Reactor& other);
+
+    void    setup(ShardGroup* shards);
+    void    registerCommands();
+    void    handleNewConnections();
+    void    parseLines(const std::vector<LineView>& lines, CycleTimes* times);
+    void    handleMessages(size_t count, CycleTimes* times);
+    void    handleTimeouts();
+    void    handleDisconnections();
+    void    closeLink(Client* client, const std::string& reason);
+    Client* findClient(int fd);
+    void    dumpTrace();
+
+    static void*    threadMain(void* reactor);
+
+    public:
+
+    Reactor(IRCServer& server, unsigned int id);
+
+    void    initialize(int port, ShardGroup* shards, EventBackendType backend);
+    void    initializeDetached(EventBackendType backend);
+    void    adoptSocket(int fd);
+    void    run();
+    void    runCycle(CycleTimes* times = NULL);
+    Metrics&    getMetrics();
+    void    start();
+    void    join();
+
+    SendQAction onSendQExceeded(int fd, size_t queuedBytes,
+        size_t messageBytes, SendPriority priority);
+};
+
+#endif
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RegistrationBurst.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:20:37 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 15:20:37 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REGISTRATION_BURST_HPP
+# define REGISTRATION_BURST_HPP
+
+# include <string>
+# include <vector>
+# include <sys/uio.h>
+# include "Client.hpp"
+# include "UserRegistry.hpp"
+# include "MessageProcessor.hpp"
+# include "NetworkManager.hpp"
+
+# define MOTD_LINE_MAX 400  // longer MOTD lines are cut to fit a 512-byte reply
+
+/*
+** The replies a client gets when registration completes: 001-005,
+** LUSERS (251, 255) and the MOTD (375/372/376 or 422).
+**
+** The burst is rendered once into a template whose only per-client
+** parts are slots (the nickname, the registered user count). Sending it is one
+** gathered write: iovecs alternate between the template and the slot
+** values, nothing is formatted per client. reload() re-renders it,
+** re-reading the MOTD file (SIGHUP).
+*/
+class RegistrationBurst
+{
+    private:
+
+    enum Slot
+    {
+        SLOT_NONE,
+        SLOT_NICK,
+        SLOT_USERS
+    };
+
+    // template bytes [offset, offset + length), followed by a slot
+    struct Segment
+    {
+        size_t  offset;
+        size_t  length;
+        Slot    slot;
+    };
+
+    NetworkManager&             _networkManager;
+    const std::string           _motdPath;
+    std::string                 _created;
+    std::string                 _template;
+    std::vector<Segment>        _segments;
+    std::vector<struct iovec>   _parts;
+
+    RegistrationBurst(const RegistrationBurst& other);
+    RegistrationBurst&  operator=(const RegistrationBurst& other);
+
+    void    text(const char* data, size_t length);
+    void    text(const char* data);
+    void    slot(Slot slot);
+    void    numeric(int code);
+    void    renderMotd();
+
+    public:
+
+    RegistrationBurst(NetworkManager& networkManager, const std::string& motdPath);
+
+    void    reload();
+    void    send(const Client& client, size_t userCount);
+    bool    completeRegistration(Client* client, UserRegistry& users);
+};
+
+#endif
@@ -0,0 +1,56 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ReplyBuilder.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:48:30 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 11:48:30 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REPLY_BUILDER_HPP
+# define REPLY_BUILDER_HPP
+
+# include <string>
+# include "MessageProcessor.hpp"
+# include "NetworkManager.hpp"
+
+/*
+** Formats one outgoing line directly into the destination connection's
+** output buffer (NetworkManager::beginReply), no temporaries:
+**
+**   ReplyBuilder(net, fd).numeric(433, nick).param(wanted)
+**       .trailing("Nickname is already in use").send();
+**
+** Output is capped at MAX_LINE_LENGTH, \r\n included; longer content is
+** truncated. Nothing reaches the client until send().
+*/
+class ReplyBuilder
+{
+    private:
+
+    NetworkManager& _networkManager;
+    int             _fd;
+    char*           _out;
+    size_t          _length;
+
+    void    append(const char* data, size_t length);
+
+    public:
+
+    ReplyBuilder(NetworkManager& networkManager, int fd);
+
+    ReplyBuilder&   numeric(int code, const std::string& target);
+    ReplyBuilder&   source(const std::string& prefix);
+    ReplyBuilder&   command(const char* command);
+    ReplyBuilder&   param(const std::string& param);
+    ReplyBuilder&   param(const StringSlice& param);
+    ReplyBuilder&   trailing(const std::string& text);
+    ReplyBuilder&   trailing(const char* text);
+    ReplyBuilder&   trailing(const StringSlice& text);
+    void            send(SendPriority priority = SEND_NORMAL);
+};
+
+#endif
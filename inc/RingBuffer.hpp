@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RingBuffer.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:02:48 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 13:02:48 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RING_BUFFER_HPP
+# define RING_BUFFER_HPP
+
+# include <cstddef>
+# include <vector>
+# include <sys/uio.h>       // struct iovec
+
+# define RING_BUFFER_SIZE 4096  // power of two
+
+/*
+** Fixed-capacity receive buffer for one connection.
+** recv() fills the free space directly (two iovecs when it wraps) and
+** complete lines are handed out as pointers into the storage, so bytes
+** are never copied between the socket and the parser. The one line
+** that may straddle the physical end is linearised into _spill.
+** Storage is allocated on first use, idle connections cost nothing.
+*/
+class RingBuffer
+{
+    private:
+
+    char*               _data;
+    size_t              _head;      // first unread byte (monotonic)
+    size_t              _tail;      // one past last written byte (monotonic)
+    size_t              _scanned;   // bytes after _head known to hold no CRLF
+    std::vector<char>   _spill;
+
+    public:
+
+    RingBuffer();
+    RingBuffer(const RingBuffer& other);
+    RingBuffer& operator=(const RingBuffer& other);
+    ~RingBuffer();
+
+    size_t  size() const;
+    size_t  available() const;
+    bool    full() const;
+
+    int     getWritableSpans(struct iovec iov[2]);
+    void    commit(size_t bytes);
+    bool    nextLine(const char*& line, size_t& length);
+    void    consume(size_t bytes);
+    void    clear();
+    void    swap(RingBuffer& other);
+
+    private:
+
+    char    at(size_t offset) const;
+};
+
+#endif
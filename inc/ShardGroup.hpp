@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ShardGroup.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 09:40:03 by odana             #+#    #+#             */
+/*   Updated: 2026/10/19 09:40:03 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SHARD_GROUP_HPP
+# define SHARD_GROUP_HPP
+
+# include <vector>
+# include <pthread.h>
+# include "SharedBuffer.hpp"
+# include "MpscQueue.hpp"
+# include "HostLimiter.hpp"
+
+# define SHARD_CHUNK_SIZE 4096  // initial size of a node of coalesced replies
+
+/*
+** One cross-shard delivery: the same bytes for one or more fds owned
+** by the destination shard. Built by the sending shard (staged), then
+** owned by the receiver once posted.
+*/
+struct ShardMessage
+{
+    ShardMessage*       next;
+    SharedBuffer        line;
+    SharedBuffer        source;     // staged only: buffer line was copied from
+    std::vector<int>    fds;
+};
+
+/*
+** Shared plumbing of the multi-reactor mode: N event loops ("shards"),
+** each with its own NetworkManager, connections and thread.
+**
+** - _owners maps every fd to the shard that accepted it
+** - a shard that sends to an fd it does not own forward()s the bytes:
+**   they are staged per destination (a broadcast to many remote members
+**   becomes one copy and one node per destination shard), posted to the
+**   destination's lock-free inbox by flush(), and the destination is
+**   woken through its eventfd
+** - the destination receive()s the nodes on its own thread and queues
+**   the bytes like any local send
+** - the per-address limits (HostLimiter) are kept here, for the group:
+**   SO_REUSEPORT spreads one host's connections over every shard
+**
+** A SharedBuffer never crosses threads while shared: only private
+** copies are posted.
+*/
+class ShardGroup
+{
+    private:
+
+    struct Shard
+    {
+        MpscQueue<ShardMessage>     inbox;
+        int                         wakeFd;
+        std::vector<ShardMessage*>  staged;     // by destination shard
+        std::vector<bool>           posted;     // by destination: wake on flush
+    };
+
+    std::vector<Shard*> _shards;
+    std::vector<int>    _owners;
+    HostLimiter         _hostLimits;
+    pthread_mutex_t     _hostLock;
+
+    ShardGroup(const ShardGroup& other);
+    ShardGroup& operator=(const ShardGroup& other);
+
+    ShardMessage*   stage(unsigned int from, unsigned int to);
+    void            post(unsigned int to, ShardMessage* message);
+
+    public:
+
+    ShardGroup(unsigned int count);
+    ~ShardGroup();
+
+    unsigned int    size() const;
+    int             getWakeFd(unsigned int shard) const;
+    void            setOwner(int fd, int shard);
+    int             getOwner(int fd) const;
+
+    bool            forward(unsigned int from, int fd, const SharedBuffer& line);
+    bool            forward(unsigned int from, int fd, const char* data, size_t length);
+    void            flush(unsigned int from);
+    ShardMessage*   receive(unsigned int shard);
+    void            wake(unsigned int shard);
+
+    HostVerdict     admitHost(uint32_t addr, unsigned long nowMs);
+    void            releaseHost(uint32_t addr);
+    void            setHostLimits(unsigned int maxPerHost, unsigned int burst,
+                        unsigned long refillMs);
+};
+
+#endif
@@ -0,0 +1,68 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SharedBuffer.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:31:20 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 15:31:20 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SHARED_BUFFER_HPP
+# define SHARED_BUFFER_HPP
+
+# include <cstddef>
+# include <string>
+
+/*
+** Immutable, reference-counted byte buffer for outbound messages.
+** A broadcast is serialized once and the same block is queued on every
+** recipient: copying a SharedBuffer only bumps a counter, so fan-out
+** costs O(1) in message size per member. The bytes live in the same
+** allocation as the header (one malloc per message, not per member).
+**
+** A buffer made with allocate() has spare capacity and may be appended
+** to (tail()/extend()) while it has a single owner; NetworkManager uses
+** this to coalesce small replies into the last queued chunk. Once
+** shared, a buffer is never modified.
+*/
+class SharedBuffer
+{
+    private:
+
+    struct Block
+    {
+        size_t  refs;
+        size_t  length;
+        size_t  capacity;
+        char    data[1];
+    };
+
+    Block*  _block;
+
+    void    release();
+    void    create(const char* data, size_t length, size_t capacity);
+
+    public:
+
+    SharedBuffer();
+    SharedBuffer(const char* data, size_t length);
+    explicit SharedBuffer(const std::string& bytes);
+    SharedBuffer(const SharedBuffer& other);
+    SharedBuffer&   operator=(const SharedBuffer& other);
+    ~SharedBuffer();
+
+    const char* data() const;
+    size_t      length() const;
+    bool        empty() const;
+    size_t      useCount() const;
+
+    static SharedBuffer allocate(size_t capacity);
+    size_t      spare() const;
+    char*       tail();
+    void        extend(size_t bytes);
+};
+
+#endif
@@ -0,0 +1,79 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TimerWheel.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:12:40 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 20:12:40 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TIMER_WHEEL_HPP
+# define TIMER_WHEEL_HPP
+
+# include <vector>
+# include <cstddef>
+
+# define TIMER_TICK_MS 100      // resolution, timers never fire early
+# define TIMER_LEVELS 5         // 32^5 ticks: about 38 days of range
+# define TIMER_SLOTS 32         // per level, one bit each in _occupied
+# define TIMER_SLOT_BITS 5
+
+typedef int TimerId;
+
+# define NO_TIMER -1
+
+/*
+** Hierarchical timing wheel (Varghese & Lauck), one per event loop.
+** Level 0 has one slot per tick, each higher level one slot per full
+** turn of the level below; a timer sits in the lowest level whose span
+** covers its delay and is cascaded down as the wheel turns.
+** - arm() / cancel() / rearm: O(1), a doubly linked list per slot with
+**   links stored as indices into a node pool (TimerIds stay valid)
+** - advance(): O(timers fired or cascaded), idle ticks are skipped
+** - nextTimeout(): O(levels), from per-level occupancy bitmaps
+** Each timer carries an owner id (a ClientHandle) reported on expiry.
+*/
+class TimerWheel
+{
+    private:
+
+    struct Node
+    {
+        int             prev;
+        int             next;
+        int             slot;       // index in _heads, -1 when not armed
+        unsigned int    owner;
+        unsigned long   expires;    // absolute tick
+    };
+
+    std::vector<Node>       _nodes;
+    std::vector<TimerId>    _free;
+    int                     _heads[TIMER_LEVELS * TIMER_SLOTS];
+    unsigned int            _occupied[TIMER_LEVELS];
+    unsigned long           _current;   // last tick processed
+    size_t                  _armed;
+
+    void    link(TimerId id);
+    void    unlink(TimerId id);
+    void    cascade(int level, unsigned int index);
+    unsigned long   nextTick() const;
+
+    public:
+
+    explicit TimerWheel(unsigned long nowMs);
+
+    TimerId create(unsigned int owner);
+    void    destroy(TimerId id);
+    void    arm(TimerId id, unsigned long deadlineMs);
+    void    cancel(TimerId id);
+    bool    isArmed(TimerId id) const;
+    size_t  size() const;
+
+    void    advance(unsigned long nowMs, std::vector<unsigned int>& expired);
+    int     nextTimeout(unsigned long nowMs) const;
+};
+
+#endif
@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Trace.hpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:12:05 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 21:12:05 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TRACE_HPP
+# define TRACE_HPP
+
+# include <string>
+# include <vector>
+# include "Metrics.hpp"
+
+# define TRACE_RING_SIZE 65536      // records per thread (power of two), 40 bytes each
+# define TRACE_MAX_THREADS 128
+
+/*
+** Hot-path trace points, compiled in with -DIRCSERV_TRACE only:
+**
+**   TRACE_SCOPE(trace, TRACE_COMMAND, fd, id, handle);  // timed to end of scope
+**   TRACE_ADD(trace, bytes);                            // adds to its arg0
+**   TRACE_INSTANT(TRACE_ACCEPT, fd, addr, 0);
+**   TRACE_THREAD("reactor", id);                        // names the thread
+**
+** Without the flag every macro expands to nothing: no code, no data, no
+** branch. With it, a trace point is one or two clock reads and one
+** fixed-size record in the calling thread's ring (TraceLog); SIGUSR2
+** writes every ring to a Chrome trace file (chrome://tracing, Perfetto).
+*/
+enum TraceEventId
+{
+    TRACE_DISPATCH,     // arg0: lines of the cycle
+    TRACE_READ,         // arg0: bytes read
+    TRACE_WRITE,        // arg0: queued bytes sent
+    TRACE_COMMAND,      // arg0: CommandId, arg1: ClientHandle
+    TRACE_BROADCAST,    // arg0: ChannelHandle, arg1: members
+    TRACE_ACCEPT,       // arg0: peer IPv4 address (network order)
+    TRACE_CLOSE,
+    TRACE_EVENT_COUNT
+};
+
+/*
+** One trace event: a span [start, start + duration) or an instant.
+** meta packs the event id (low 16 bits), an instant flag and the fd.
+*/
+struct TraceRecord
+{
+    unsigned long   start;      // ns, Metrics::clock()
+    unsigned long   duration;
+    unsigned long   meta;
+    unsigned long   arg0;
+    unsigned long   arg1;
+};
+
+/*
+** Per-thread ring of the last TRACE_RING_SIZE records. Only the owning
+** thread writes, lock-free; the dumper reads it concurrently and keeps
+** only the records that cannot have been overwritten meanwhile
+** (seqlock-style: _claimed is bumped before a slot is reused, _head
+** after it is complete).
+*/
+class TraceRing
+{
+    private:
+
+    TraceRecord     _records[TRACE_RING_SIZE];
+    unsigned long   _claimed;
+    unsigned long   _head;
+    std::string     _name;
+
+    TraceRing(const TraceRing& other);
+    TraceRing&  operator=(const TraceRing& other);
+
+    public:
+
+    explicit TraceRing(const std::string& name);
+
+    void    push(const TraceRecord& record);
+    void    snapshot(std::vector<TraceRecord>& out) const;
+    const std::string&  getName() const;
+};
+
+/*
+** Process-wide registry of the rings, one per thread that traced
+** something (created on its first record, or named by registerThread()).
+*/
+class TraceLog
+{
+    private:
+
+    static TraceRing*   _rings[TRACE_MAX_THREADS];
+    static unsigned int _count;
+
+    static TraceRing*   create(const std::string& name);
+
+    public:
+
+    static void registerThread(const char* name, unsigned int id);
+    static void record(TraceEventId event, int fd, unsigned long start,
+        unsigned long duration, unsigned long arg0, unsigned long arg1);
+    static void instant(TraceEventId event, int fd, unsigned long arg0, unsigned long arg1);
+    static bool dump(const std::string& path);
+};
+
+/*
+** RAII span: recorded when it goes out of scope (see TRACE_SCOPE).
+*/
+class TraceScope
+{
+    private:
+
+    TraceEventId    _event;
+    int             _fd;
+    unsigned long   _start;
+
+    TraceScope(const TraceScope& other);
+    TraceScope& operator=(const TraceScope& other);
+
+    public:
+
+    unsigned long   arg0;
+    unsigned long   arg1;
+
+    TraceScope(TraceEventId event, int fd, unsigned long a0, unsigned long a1)
+        : _event(event), _fd(fd), _start(Metrics::clock()), arg0(a0), arg1(a1) {}
+    ~TraceScope()
+    {
+        TraceLog::record(_event, _fd, _start, Metrics::clock() - _start, arg0, arg1);
+    }
+};
+
+# ifdef IRCSERV_TRACE
+#  define TRACE_SCOPE(var, event, fd, arg0, arg1) TraceScope var(event, fd, arg0, arg1)
+#  define TRACE_ADD(var, value) (var.arg0 += (value))
+#  define TRACE_INSTANT(event, fd, arg0, arg1) TraceLog::instant(event, fd, arg0, arg1)
+#  define TRACE_THREAD(name, id) TraceLog::registerThread(name, id)
+# else
+#  define TRACE_SCOPE(var, event, fd, arg0, arg1) ((void)0)
+#  define TRACE_ADD(var, value) ((void)0)
+#  define TRACE_INSTANT(event, fd, arg0, arg1) ((void)0)
+#  define TRACE_THREAD(name, id) ((void)0)
+# endif
+
+#endif
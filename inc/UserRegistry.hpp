@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UserRegistry.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:02:11 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 14:02:11 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef USER_REGISTRY_HPP
+# define USER_REGISTRY_HPP
+
+# include <vector>
+# include <string>
+# include "Client.hpp"
+# include "ClientPool.hpp"
+
+# define NICK_TABLE_MIN_CAPACITY 64  // power of two
+
+/*
+** Every connected client, by handle and (once it has one) by nickname.
+** The registry owns the Client objects, allocated from a ClientPool.
+**
+** - by handle: the pool, stale handles resolve to NULL. There is no
+**   fd index here: an fd number is reused by the kernel as soon as it
+**   is closed, possibly by another reactor, so each reactor maps its
+**   own fds to handles
+** - by nickname: an open-addressing hash table (linear probing, at most
+**   half full) keyed on the folded atom of the client's nickname, the
+**   way ChannelRegistry keys channels: a slot is the cached hash and
+**   the client, names compare as atoms. Lookups fold the query into a
+**   stack buffer and find its atom; a name nobody interned cannot be
+**   taken. No allocation, no string tree, no copy of the nickname.
+**   Removal shifts the following cluster back instead of leaving
+**   tombstones.
+**
+** Nicknames are at most NICKLEN long (NickCommand enforces it), so a
+** longer name is simply never found.
+*/
+class UserRegistry
+{
+    private:
+
+    struct NickSlot
+    {
+        unsigned int    hash;
+        Client*         client;     // NULL: free slot
+    };
+
+    ClientPool              _clients;
+    std::vector<NickSlot>   _nickSlots;
+    size_t                  _nickCount;
+    size_t                  _registeredCount;
+
+    UserRegistry(const UserRegistry& other);
+    UserRegistry&   operator=(const UserRegistry& other);
+
+    size_t  findSlot(Atom folded) const;
+    void    insertNick(Client* client);
+    void    eraseNick(Client* client);
+    void    growNickTable();
+
+    public:
+
+    UserRegistry();
+    ~UserRegistry();
+
+    Client* createClient(int fd);
+    void    removeClient(ClientHandle handle);
+
+    Client* getClient(ClientHandle handle);
+    Client* getClientByNick(const std::string& nick);
+    bool    isNickAvailable(const std::string& nick);
+    void    updateNickname(Client* client, const std::string& newNick);
+    void    markRegistered(Client* client);
+    size_t  getClientCount() const;
+    size_t  getRegisteredCount() const;
+};
+
+#endif
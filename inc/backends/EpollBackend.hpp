@@ -0,0 +1,51 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EpollBackend.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:11:03 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 10:11:03 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef EPOLL_BACKEND_HPP
+# define EPOLL_BACKEND_HPP
+
+# ifdef __linux__
+
+#  include <vector>
+#  include <sys/epoll.h>
+#  include "../IEventBackend.hpp"
+
+/*
+** Edge-triggered epoll backend (Linux default).
+** The kernel keeps the interest set, epoll_wait() hands back only ready
+** fds, so per-iteration cost is O(ready) rather than O(connections).
+*/
+class EpollBackend : public IEventBackend
+{
+    private:
+
+    int                             _epollFd;
+    std::vector<struct epoll_event> _readyEvents;
+
+    EpollBackend(const EpollBackend& other);
+    EpollBackend&   operator=(const EpollBackend& other);
+
+    public:
+
+    EpollBackend();
+    ~EpollBackend();
+
+    void    addFd(int fd);
+    void    removeFd(int fd);
+    void    setWriteInterest(int fd, bool enabled);
+    int     wait(std::vector<IOEvent>& events, int timeoutMs);
+    const char* getName() const;
+};
+
+# endif
+
+#endif
@@ -0,0 +1,48 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PollBackend.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:05:40 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 10:05:40 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef POLL_BACKEND_HPP
+# define POLL_BACKEND_HPP
+
+# include <vector>
+# include <poll.h>
+# include "../IEventBackend.hpp"
+
+/*
+** Portable fallback: level-triggered poll() over a dense pollfd array.
+** _slotByFd maps fd -> index in _pollFds so add/remove/modify are O(1)
+** (removal swaps the last slot into the hole).
+*/
+class PollBackend : public IEventBackend
+{
+    private:
+
+    std::vector<struct pollfd>  _pollFds;
+    std::vector<int>            _slotByFd;
+
+    PollBackend(const PollBackend& other);
+    PollBackend&    operator=(const PollBackend& other);
+
+    public:
+
+    PollBackend();
+    ~PollBackend();
+
+    void    addFd(int fd);
+    void    removeFd(int fd);
+    void    setWriteInterest(int fd, bool enabled);
+    void    setReadInterest(int fd, bool enabled);
+    int     wait(std::vector<IOEvent>& events, int timeoutMs);
+    const char* getName() const;
+};
+
+#endif
@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UringBackend.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:05:12 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 19:05:12 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef URING_BACKEND_HPP
+# define URING_BACKEND_HPP
+
+# ifdef __linux__
+
+#  include <vector>
+#  include <sys/uio.h>
+#  include <sys/socket.h>
+#  include <linux/io_uring.h>
+#  include "../IEventBackend.hpp"
+#  include "../SharedBuffer.hpp"
+
+#  define URING_SQ_ENTRIES 1024     // submissions per io_uring_enter()
+#  define URING_CQ_ENTRIES 8192     // room for multishot bursts
+#  define URING_BUFFER_COUNT 512    // provided recv buffers (power of 2)
+#  define URING_BUFFER_SIZE 4096    // bytes per recv completion, at most
+#  define URING_BUFFER_GROUP 0
+#  define URING_SEND_BATCH 64       // iovecs per sendmsg
+#  define URING_ACCEPT_BACKOFF_MS 100
+
+/*
+** io_uring completion backend (Linux 6.0+, opt-in).
+** One io_uring_enter() per wait() submits everything queued since the
+** last one and reaps the completions:
+** - the listener has one multishot accept (SOCK_NONBLOCK, no fcntl)
+** - each connection has one multishot recv picking buffers from a
+**   provided-buffer ring registered with the kernel; a completion
+**   points into that buffer until releaseBuffer() recycles it
+** - each connection has at most one sendmsg in flight, gathering its
+**   queued buffers (pinned by reference until the send completes)
+** - other fds (the shard wakeup eventfd) use multishot poll and are
+**   reported as plain EVENT_READ readiness
+** Every request tags its user_data with the fd and the fd's generation,
+** bumped on removeFd(), so completions for a closed fd whose number
+** was reused meanwhile are recognized and dropped.
+*/
+class UringBackend : public IEventBackend
+{
+    private:
+
+    enum FdRole
+    {
+        FD_UNUSED,
+        FD_WATCHED,     // multishot poll (readiness)
+        FD_LISTENER,    // multishot accept
+        FD_CONNECTION   // multishot recv + sendmsg
+    };
+
+    struct FdState
+    {
+        unsigned short  generation;
+        unsigned char   armSeq;     // bumped when a multishot is cancelled
+        unsigned char   role;
+        bool            armed;      // multishot request outstanding
+        bool            paused;     // setReadInterest(false)
+        int             sendOp;     // in-flight send, -1 if none
+
+        FdState();
+    };
+
+    struct SendOp
+    {
+        int             fd;
+        unsigned short  generation;
+        size_t          pinned;
+        struct msghdr   msg;
+        struct iovec    iov[URING_SEND_BATCH];
+        SharedBuffer    pins[URING_SEND_BATCH];
+    };
+
+    int                     _ringFd;
+    void*                   _sqRing;
+    size_t                  _sqRingSize;
+    void*                   _cqRing;
+    size_t                  _cqRingSize;
+    struct io_uring_sqe*    _sqes;
+    size_t                  _sqesSize;
+    unsigned*               _sqHead;
+    unsigned*               _sqTail;
+    unsigned                _sqMask;
+    unsigned                _sqEntries;
+    unsigned                _sqLocalTail;
+    unsigned*               _cqHead;
+    unsigned*               _cqTail;
+    unsigned                _cqMask;
+    struct io_uring_cqe*    _cqes;
+
+    struct io_uring_buf_ring*   _bufRing;
+    char*                   _buffers;
+    unsigned short          _bufTail;
+
+    std::vector<FdState>    _fds;
+    std::vector<SendOp*>    _sendOps;
+    std::vector<int>        _freeSendOps;
+    struct __kernel_timespec    _acceptBackoff;
+
+    UringBackend(const UringBackend& other);
+    UringBackend&   operator=(const UringBackend& other);
+
+    void    setupRing();
+    void    setupBuffers();
+    bool    probeOpcode(int opcode);
+    void    teardown();
+    FdState*    state(int fd);
+    FdState&    track(int fd, FdRole role);
+    struct io_uring_sqe*    nextSqe();
+    int     enter(unsigned minComplete, int timeoutMs);
+    void    armAccept(int fd, const FdState& st);
+    void    armRecv(int fd, FdState& st);
+    void    armPoll(int fd, const FdState& st);
+    void    armBackoff(int fd, const FdState& st);
+    void    cancel(__u64 userData);
+    void    recycleBuffer(int bid);
+    void    completeFd(const struct io_uring_cqe& cqe, std::vector<IOEvent>& events);
+    void    completeSend(const struct io_uring_cqe& cqe, std::vector<IOEvent>& events);
+
+    public:
+
+    UringBackend();
+    ~UringBackend();
+
+    void    addFd(int fd);
+    void    removeFd(int fd);
+    void    setWriteInterest(int fd, bool enabled);
+    int     wait(std::vector<IOEvent>& events, int timeoutMs);
+    const char* getName() const;
+
+    bool    completesIO() const;
+    void    addListener(int fd);
+    void    addConnection(int fd);
+    void    setReadInterest(int fd, bool enabled);
+    void    releaseBuffer(const IOEvent& event);
+    bool    submitSend(int fd, const SharedBuffer* parts, size_t count, size_t offset);
+};
+
+# endif
+
+#endif
@@ -13,15 +13,39 @@
 #ifndef NICK_COMMAND_HPP
 # define NICK_COMMAND_HPP
 
-// TODO @yitani
+# include <string>
+# include "../ICommand.hpp"
+# include "../NetworkManager.hpp"
+# include "../UserRegistry.hpp"
+# include "../RegistrationBurst.hpp"
 
 /* FORMAT: NICK <nickname>
 ** 
-** check if nickname provided -> no password parameter -> error 461
-** check nickname format (alphanumeric, within max lengh, no spaces) -> already registered -> error 462
-** check if nickname taken --> taken --> error 463
-** update nickname in user registry
+** check if password given -> not yet -> error 451
+** check if nickname provided -> no nickname parameter -> error 431
+** check nickname format (letter/special first, within NICKLEN, no spaces) -> error 432
+** check if nickname taken (RFC 1459 casemapping, own nick excepted) --> taken --> error 433
+** update nickname in user registry (registered clients see the NICK change)
 ** if fully registered now (pass + nick + user) --> AUTHENTICATING to REGISTERED --> send welcome message
 */
+class NickCommand : public ICommand
+{
+    private:
 
-#endif
\ No newline at end of file
+    NetworkManager&     _networkManager;
+    UserRegistry&       _userRegistry;
+    RegistrationBurst&  _registrationBurst;
+
+    static bool isValidNickname(const std::string& nick);
+
+    public:
+
+    NickCommand(NetworkManager& networkManager, UserRegistry& userRegistry,
+        RegistrationBurst& registrationBurst);
+
+    void    execute(Client* client, const IRCMessage& msg);
+    void    executeView(Client* client, const IRCMessageView& msg);
+    bool    requiresAuth() const;
+};
+
+#endif
@@ -13,6 +13,31 @@
 #ifndef PASS_COMMAND_HPP
 # define PASS_COMMAND_HPP
 
-// TODO @yitani
+# include <string>
+# include "../ICommand.hpp"
+# include "../NetworkManager.hpp"
 
-#endif
\ No newline at end of file
+/* FORMAT: PASS <password>
+** 
+** check if already registered -> error 462
+** check if password provided -> no password parameter -> error 461
+** check password   --> correct: change client state from CONNECTING TO AUTHENTICATING
+**                  --> incorrect: error 464, then ERROR and the link is closed
+*/
+class PassCommand : public ICommand
+{
+    private:
+
+    NetworkManager&     _networkManager;
+    const std::string   _password;
+
+    public:
+
+    PassCommand(NetworkManager& networkManager, const std::string& password);
+
+    void    execute(Client* client, const IRCMessage& msg);
+    void    executeView(Client* client, const IRCMessageView& msg);
+    bool    requiresAuth() const;
+};
+
+#endif
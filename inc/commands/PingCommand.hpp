@@ -0,0 +1,40 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PingCommand.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:41:03 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 20:41:03 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PING_COMMAND_HPP
+# define PING_COMMAND_HPP
+
+# include "../ICommand.hpp"
+# include "../NetworkManager.hpp"
+
+/* FORMAT: PING <token>
+**
+** check if token provided -> no token -> error 409
+** answer PONG with the token: ":ircserv PONG ircserv :<token>"
+** allowed before registration (clients measure lag while registering)
+*/
+class PingCommand : public ICommand
+{
+    private:
+
+    NetworkManager& _networkManager;
+
+    public:
+
+    PingCommand(NetworkManager& networkManager);
+
+    void    execute(Client* client, const IRCMessage& msg);
+    void    executeView(Client* client, const IRCMessageView& msg);
+    bool    requiresAuth() const;
+};
+
+#endif
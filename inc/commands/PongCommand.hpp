@@ -0,0 +1,33 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PongCommand.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:41:03 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 20:41:03 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PONG_COMMAND_HPP
+# define PONG_COMMAND_HPP
+
+# include "../ICommand.hpp"
+
+/* FORMAT: PONG <token>
+**
+** answer to the server's keepalive PING: nothing to do here, every line
+** a client sends already counts as activity (see Reactor::handleTimeouts)
+** the handler only keeps PONG from being an unknown command (421)
+*/
+class PongCommand : public ICommand
+{
+    public:
+
+    void    execute(Client* client, const IRCMessage& msg);
+    void    executeView(Client* client, const IRCMessageView& msg);
+    bool    requiresAuth() const;
+};
+
+#endif
@@ -0,0 +1,52 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StatsCommand.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:04:12 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 19:04:12 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef STATS_COMMAND_HPP
+# define STATS_COMMAND_HPP
+
+# include "../ICommand.hpp"
+# include "../NetworkManager.hpp"
+
+class IRCServer;
+
+/* FORMAT: STATS <query>
+**
+** runtime metrics of every event loop, summed (IRCServer::collectMetrics)
+** m -> 212 RPL_STATSCOMMANDS per command used: <command> <count> 0 0
+** u -> 242 RPL_STATSUPTIME ":Server Up <d> days <h>:<mm>:<ss>"
+** p -> 249 RPL_STATSDEBUG lines: loop, traffic, connections, SendQ
+**      and per-command latencies (p50/p99/max)
+** always ends with 219 RPL_ENDOFSTATS (query "*" when none given)
+** registered clients only; there are no operators yet
+*/
+class StatsCommand : public ICommand
+{
+    private:
+
+    NetworkManager& _networkManager;
+    IRCServer&      _server;
+
+    void    sendCommands(Client* client, const Metrics& metrics);
+    void    sendUptime(Client* client);
+    void    sendPerformance(Client* client, const Metrics& metrics);
+    void    sendDebug(Client* client, const std::string& text);
+
+    public:
+
+    StatsCommand(NetworkManager& networkManager, IRCServer& server);
+
+    void    execute(Client* client, const IRCMessage& msg);
+    void    executeView(Client* client, const IRCMessageView& msg);
+    bool    requiresAuth() const;
+};
+
+#endif
@@ -13,6 +13,35 @@
 #ifndef USER_COMMAND_HPP
 # define USER_COMMAND_HPP
 
-// TODO @yitani
+# include "../ICommand.hpp"
+# include "../NetworkManager.hpp"
+# include "../UserRegistry.hpp"
+# include "../RegistrationBurst.hpp"
 
-#endif
\ No newline at end of file
+/* FORMAT: USER <username> <mode> <unused> :<realname>
+** 
+** check if password given -> not yet -> error 451
+** check if already registered (or USER already given) -> error 462
+** check parameters -> fewer than 4 -> error 461
+** store username and realname
+** if fully registered now (pass + nick + user) --> AUTHENTICATING to REGISTERED --> send welcome message
+*/
+class UserCommand : public ICommand
+{
+    private:
+
+    NetworkManager&     _networkManager;
+    UserRegistry&       _userRegistry;
+    RegistrationBurst&  _registrationBurst;
+
+    public:
+
+    UserCommand(NetworkManager& networkManager, UserRegistry& userRegistry,
+        RegistrationBurst& registrationBurst);
+
+    void    execute(Client* client, const IRCMessage& msg);
+    void    executeView(Client* client, const IRCMessageView& msg);
+    bool    requiresAuth() const;
+};
+
+#endif
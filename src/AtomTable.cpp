@@ -0,0 +1,237 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AtomTable.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:36:10 by odana             #+#    #+#             */
+/*   Updated: 2026/10/18 15:36:10 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/AtomTable.hpp"
+#include "../inc/CaseMapping.hpp"
+#include <cstring>
+
+AtomTable::AtomTable() : _count(0)
+{
+    Entry   empty;
+    Slot    free = { 0, NO_ATOM };
+
+    empty.folded = NO_ATOM;
+    empty.hash = 0;
+    empty.refs = 0;
+    _entries.push_back(empty);
+    _slots.assign(ATOM_TABLE_MIN_CAPACITY, free);
+}
+
+/*
+** instance()
+** The process-wide table, shared by every registry.
+*/
+AtomTable&  AtomTable::instance()
+{
+    static AtomTable    table;
+
+    return (table);
+}
+
+/*
+** findSlot(const char* text, size_t length, unsigned int hash) [PRIVATE]
+** Linear probe from the string's home slot.
+**
+** Returns: index of the slot holding the string, or of the free slot
+**          that ends its probe sequence (the table is never full)
+*/
+size_t  AtomTable::findSlot(const char* text, size_t length, unsigned int hash) const
+{
+    size_t  mask = _slots.size() - 1;
+    size_t  i = hash & mask;
+
+    while (_slots[i].atom != NO_ATOM)
+    {
+        if (_slots[i].hash == hash)
+        {
+            const std::string& candidate = _entries[_slots[i].atom].text;
+            if (candidate.length() == length && std::memcmp(candidate.data(), text, length) == 0)
+                break ;
+        }
+        i = (i + 1) & mask;
+    }
+    return (i);
+}
+
+/*
+** intern(const char* text, size_t length)
+** Returns: the atom for text, with one more reference (NO_ATOM for "")
+*/
+Atom    AtomTable::intern(const char* text, size_t length)
+{
+    if (length == 0)
+        return (NO_ATOM);
+
+    unsigned int    hash = CaseMapping::hash(text, length);
+    size_t          i = findSlot(text, length, hash);
+    if (_slots[i].atom != NO_ATOM)
+    {
+        _entries[_slots[i].atom].refs++;
+        return (_slots[i].atom);
+    }
+
+    Atom atom;
+    if (!_freeAtoms.empty())
+    {
+        atom = _freeAtoms.back();
+        _freeAtoms.pop_back();
+    }
+    else
+    {
+        atom = _entries.size();
+        _entries.push_back(_entries[NO_ATOM]);
+    }
+    _entries[atom].text.assign(text, length);
+    _entries[atom].hash = hash;
+    _entries[atom].refs = 1;
+    _entries[atom].folded = atom;
+
+    if ((_count + 1) * 2 > _slots.size())
+        growSlots();
+    Slot slot = { hash, atom };
+    _slots[findSlot(text, length, hash)] = slot;
+    _count++;
+
+    // _entries may move while the folded form is interned
+    std::string folded = CaseMapping::fold(_entries[atom].text);
+    if (folded != _entries[atom].text)
+    {
+        Atom foldedAtom = intern(folded);
+        _entries[atom].folded = foldedAtom;
+    }
+    return (atom);
+}
+
+Atom    AtomTable::intern(const std::string& text)
+{
+    return (intern(text.data(), text.length()));
+}
+
+/*
+** find(const char* text, size_t length)
+** Returns: the atom for text if it is interned (no reference taken),
+**          NO_ATOM otherwise
+*/
+Atom    AtomTable::find(const char* text, size_t length) const
+{
+    if (length == 0)
+        return (NO_ATOM);
+    return (_slots[findSlot(text, length, CaseMapping::hash(text, length))].atom);
+}
+
+Atom    AtomTable::find(const std::string& text) const
+{
+    return (find(text.data(), text.length()));
+}
+
+void    AtomTable::retain(Atom atom)
+{
+    if (atom != NO_ATOM)
+        _entries[atom].refs++;
+}
+
+/*
+** release(Atom atom)
+** Drops a reference; the last one frees the entry and its id.
+*/
+void    AtomTable::release(Atom atom)
+{
+    if (atom == NO_ATOM || --_entries[atom].refs != 0)
+        return ;
+
+    Atom folded = _entries[atom].folded;
+    eraseSlot(atom);
+    _entries[atom].text.clear();
+    _entries[atom].folded = NO_ATOM;
+    _freeAtoms.push_back(atom);
+    _count--;
+    if (folded != atom)
+        release(folded);
+}
+
+/*
+** eraseSlot(Atom atom) [PRIVATE]
+** Frees the atom's slot and shifts the rest of its cluster back (see
+** UserRegistry::eraseNick()).
+*/
+void    AtomTable::eraseSlot(Atom atom)
+{
+    const Entry&    entry = _entries[atom];
+    size_t          mask = _slots.size() - 1;
+    size_t          hole = findSlot(entry.text.data(), entry.text.length(), entry.hash);
+
+    if (_slots[hole].atom != atom)
+        return ;
+    for (size_t j = (hole + 1) & mask; _slots[j].atom != NO_ATOM; j = (j + 1) & mask)
+    {
+        size_t  home = _slots[j].hash & mask;
+        bool    stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+        if (stays)
+            continue ;
+        _slots[hole] = _slots[j];
+        hole = j;
+    }
+    _slots[hole].atom = NO_ATOM;
+}
+
+/*
+** growSlots() [PRIVATE]
+** Doubles the index and re-inserts every atom (hashes are cached).
+*/
+void    AtomTable::growSlots()
+{
+    std::vector<Slot>   old;
+    Slot                free = { 0, NO_ATOM };
+
+    old.swap(_slots);
+    _slots.assign(old.size() * 2, free);
+
+    size_t  mask = _slots.size() - 1;
+    for (size_t i = 0; i < old.size(); i++)
+    {
+        if (old[i].atom == NO_ATOM)
+            continue ;
+        size_t  j = old[i].hash & mask;
+        while (_slots[j].atom != NO_ATOM)
+            j = (j + 1) & mask;
+        _slots[j] = old[i];
+    }
+}
+
+const std::string&  AtomTable::text(Atom atom) const
+{
+    return (_entries[atom].text);
+}
+
+/*
+** hash(Atom atom)
+** Returns: CaseMapping::hash() of the atom's text, cached
+*/
+unsigned int    AtomTable::hash(Atom atom) const
+{
+    return (_entries[atom].hash);
+}
+
+Atom    AtomTable::folded(Atom atom) const
+{
+    return (_entries[atom].folded);
+}
+
+bool    AtomTable::sameName(Atom a, Atom b) const
+{
+    return (_entries[a].folded == _entries[b].folded);
+}
+
+size_t  AtomTable::size() const
+{
+    return (_count);
+}
@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CaseMapping.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:52:44 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 18:52:44 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/CaseMapping.hpp"
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+/*
+** Fold table for all 256 byte values, built once at startup.
+*/
+struct CaseTable
+{
+    unsigned char   lower[256];
+
+    CaseTable()
+    {
+        for (int c = 0; c < 256; c++)
+            lower[c] = (c >= 'A' && c <= '^') ? c + ('a' - 'A') : c;
+    }
+};
+
+static const CaseTable  g_caseTable;
+
+unsigned char   CaseMapping::toLower(unsigned char c)
+{
+    return (g_caseTable.lower[c]);
+}
+
+/*
+** fold(const char* src, size_t length, char* dst)
+** Writes the folded form of src to dst (may be the same buffer).
+** The folded range 'A'..'^' is contiguous and maps by +0x20, so with
+** SSE2 16 bytes are folded at once: bytes in (0x40, 0x5F) get 0x20
+** added. Bytes >= 0x80 compare as negative and are left alone. The
+** tail (and every short nickname) goes through the table.
+*/
+void    CaseMapping::fold(const char* src, size_t length, char* dst)
+{
+    size_t  i = 0;
+
+#ifdef __SSE2__
+    const __m128i   low = _mm_set1_epi8('A' - 1);
+    const __m128i   high = _mm_set1_epi8('^' + 1);
+    const __m128i   delta = _mm_set1_epi8('a' - 'A');
+
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chunk, low), _mm_cmplt_epi8(chunk, high));
+        chunk = _mm_add_epi8(chunk, _mm_and_si128(upper, delta));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), chunk);
+    }
+#endif
+    for (; i < length; i++)
+        dst[i] = g_caseTable.lower[static_cast<unsigned char>(src[i])];
+}
+
+std::string CaseMapping::fold(const std::string& name)
+{
+    std::string folded(name);
+
+    if (!folded.empty())
+        fold(folded.data(), folded.length(), &folded[0]);
+    return (folded);
+}
+
+/*
+** equals(const char* a, const char* b, size_t length)
+** Case-insensitive compare of two same-length names.
+*/
+bool    CaseMapping::equals(const char* a, const char* b, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+        if (g_caseTable.lower[static_cast<unsigned char>(a[i])]
+            != g_caseTable.lower[static_cast<unsigned char>(b[i])])
+            return (false);
+    return (true);
+}
+
+/*
+** hash(const char* folded, size_t length)
+** FNV-1a over an already folded name.
+*/
+unsigned int    CaseMapping::hash(const char* folded, size_t length)
+{
+    unsigned int    h = 2166136261u;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        h ^= static_cast<unsigned char>(folded[i]);
+        h *= 16777619u;
+    }
+    return (h);
+}
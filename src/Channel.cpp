@@ -0,0 +1,222 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Channel.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:31:48 by odana             #+#    #+#             */
+/*   Updated: 2026/10/18 10:31:48 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/Channel.hpp"
+
+/*
+** Channel(ChannelHandle handle, const std::string& name)
+** The name is interned; its folded form comes with the atom.
+*/
+Channel::Channel(ChannelHandle handle, const std::string& name)
+    : _handle(handle), _name(AtomTable::instance().intern(name)),
+    _userLimit(0), _modes(0), _joinedCount(0) {}
+
+Channel::~Channel()
+{
+    AtomTable::instance().release(_name);
+}
+
+ChannelHandle   Channel::getHandle() const
+{
+    return (_handle);
+}
+
+const std::string&  Channel::getName() const
+{
+    return (AtomTable::instance().text(_name));
+}
+
+const std::string&  Channel::getFoldedName() const
+{
+    const AtomTable&    atoms = AtomTable::instance();
+
+    return (atoms.text(atoms.folded(_name)));
+}
+
+Atom    Channel::getNameAtom() const
+{
+    return (_name);
+}
+
+const std::string&  Channel::getTopic() const
+{
+    return (_topic);
+}
+
+const std::string&  Channel::getKey() const
+{
+    return (_key);
+}
+
+size_t  Channel::getUserLimit() const
+{
+    return (_userLimit);
+}
+
+size_t  Channel::getMemberCount() const
+{
+    return (_joinedCount);
+}
+
+const std::vector<Member>&  Channel::getMembers() const
+{
+    return (_members);
+}
+
+void    Channel::setTopic(const std::string& topic)
+{
+    _topic = topic;
+}
+
+void    Channel::setKey(const std::string& key)
+{
+    _key = key;
+}
+
+void    Channel::setUserLimit(size_t limit)
+{
+    _userLimit = limit;
+}
+
+bool    Channel::hasMode(ChannelModes mode) const
+{
+    return ((_modes & mode) != 0);
+}
+
+void    Channel::setMode(ChannelModes mode, bool enabled)
+{
+    if (enabled)
+        _modes |= mode;
+    else
+        _modes &= ~mode;
+}
+
+/*
+** findMember(ClientHandle client) [PRIVATE]
+** Returns: the client's entry (member or pending invite), NULL if none
+*/
+Member* Channel::findMember(ClientHandle client)
+{
+    for (size_t i = 0; i < _members.size(); i++)
+        if (_members[i].client == client)
+            return (&_members[i]);
+    return (NULL);
+}
+
+/*
+** addMember(ClientHandle client, int fd, unsigned int flags)
+** Joins client (connected on fd) with the given extra flags (MEMBER_OP
+** for the creator). A pending invite is consumed.
+**
+** Returns: false if the client already is a member
+*/
+bool    Channel::addMember(ClientHandle client, int fd, unsigned int flags)
+{
+    Member* member = findMember(client);
+    if (member != NULL && (member->flags & MEMBER_JOINED))
+        return (false);
+
+    flags = (flags | MEMBER_JOINED) & ~MEMBER_INVITED;
+    if (member != NULL)
+    {
+        member->fd = fd;
+        member->flags = flags;
+    }
+    else
+    {
+        Member entry = { client, fd, flags };
+        _members.push_back(entry);
+    }
+    _joinedCount++;
+    return (true);
+}
+
+/*
+** removeMember(ClientHandle client)
+** Drops the client's entry (membership and invite) with a swap-remove:
+** member order carries no meaning.
+**
+** Returns: true if the client was a member
+*/
+bool    Channel::removeMember(ClientHandle client)
+{
+    Member* member = findMember(client);
+    if (member == NULL)
+        return (false);
+
+    bool joined = (member->flags & MEMBER_JOINED) != 0;
+    *member = _members.back();
+    _members.pop_back();
+    if (joined)
+        _joinedCount--;
+    return (joined);
+}
+
+bool    Channel::isMember(ClientHandle client)
+{
+    return (hasFlag(client, MEMBER_JOINED));
+}
+
+bool    Channel::hasFlag(ClientHandle client, MemberFlags flag)
+{
+    Member* member = findMember(client);
+    return (member != NULL && (member->flags & flag) != 0);
+}
+
+/*
+** setFlag(ClientHandle client, MemberFlags flag, bool enabled)
+** Sets op/voice on a member. Ignored for non-members.
+*/
+void    Channel::setFlag(ClientHandle client, MemberFlags flag, bool enabled)
+{
+    Member* member = findMember(client);
+    if (member == NULL || !(member->flags & MEMBER_JOINED))
+        return ;
+    if (enabled)
+        member->flags |= flag;
+    else
+        member->flags &= ~flag;
+}
+
+/*
+** invite(ClientHandle client)
+** Records an invite; it is consumed by the next addMember().
+*/
+void    Channel::invite(ClientHandle client)
+{
+    Member* member = findMember(client);
+    if (member != NULL)
+    {
+        if (!(member->flags & MEMBER_JOINED))
+            member->flags |= MEMBER_INVITED;
+        return ;
+    }
+    Member entry = { client, -1, MEMBER_INVITED };
+    _members.push_back(entry);
+}
+
+/*
+** broadcast(NetworkManager& networkManager, const SharedBuffer& line, ClientHandle except)
+** Queues the same line to every member but except: one pass over the
+** member array, one reference per recipient.
+*/
+void    Channel::broadcast(NetworkManager& networkManager, const SharedBuffer& line,
+            ClientHandle except)
+{
+    TRACE_SCOPE(trace, TRACE_BROADCAST, -1, _handle, _members.size());
+    for (size_t i = 0; i < _members.size(); i++)
+    {
+        const Member& member = _members[i];
+        if ((member.flags & MEMBER_JOINED) && member.client != except)
+            networkManager.sendMessage(member.fd, line);
+    }
+}
@@ -0,0 +1,212 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChannelRegistry.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 11:40:27 by odana             #+#    #+#             */
+/*   Updated: 2026/10/18 11:40:27 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/ChannelRegistry.hpp"
+#include "../inc/CaseMapping.hpp"
+
+ChannelRegistry::ChannelRegistry() : _channelCount(0)
+{
+    NameSlot    empty = { 0, INVALID_CHANNEL };
+
+    _nameSlots.assign(CHANNEL_TABLE_MIN_CAPACITY, empty);
+}
+
+ChannelRegistry::~ChannelRegistry()
+{
+    for (size_t i = 0; i < _channels.size(); i++)
+        delete _channels[i];
+}
+
+/*
+** findSlot(Atom folded) [PRIVATE]
+** Linear probe from the name's home slot. Names are compared as atoms.
+**
+** Returns: index of the slot holding the name, or of the free slot
+**          that ends its probe sequence (the table is never full)
+*/
+size_t  ChannelRegistry::findSlot(Atom folded) const
+{
+    const AtomTable&    atoms = AtomTable::instance();
+    unsigned int        hash = atoms.hash(folded);
+    size_t              mask = _nameSlots.size() - 1;
+    size_t              i = hash & mask;
+
+    while (_nameSlots[i].handle != INVALID_CHANNEL)
+    {
+        if (_nameSlots[i].hash == hash
+            && atoms.folded(_channels[_nameSlots[i].handle]->getNameAtom()) == folded)
+            break ;
+        i = (i + 1) & mask;
+    }
+    return (i);
+}
+
+/*
+** createChannel(const std::string& name, Client* creator)
+** Creates the channel with creator as its first member and operator.
+** The caller checked getChannel(name) is NULL and validated the name.
+*/
+Channel*    ChannelRegistry::createChannel(const std::string& name, Client* creator)
+{
+    if (name.empty() || name.length() > CHANNELLEN)
+        return (NULL);
+    if ((_channelCount + 1) * 2 > _nameSlots.size())
+        growNameTable();
+
+    ChannelHandle handle;
+    if (!_freeHandles.empty())
+    {
+        handle = _freeHandles.back();
+        _freeHandles.pop_back();
+    }
+    else
+    {
+        handle = _channels.size();
+        _channels.push_back(NULL);
+    }
+
+    Channel* channel = new Channel(handle, name);
+    _channels[handle] = channel;
+
+    Atom        folded = AtomTable::instance().folded(channel->getNameAtom());
+    NameSlot    slot = { AtomTable::instance().hash(folded), handle };
+    _nameSlots[findSlot(folded)] = slot;
+    _channelCount++;
+
+    if (creator != NULL)
+    {
+        channel->addMember(creator->getHandle(), creator->getFd(), MEMBER_OP);
+        creator->joinChannel(handle);
+    }
+    return (channel);
+}
+
+/*
+** getChannel(const std::string& name)
+** Folds name on the stack; a name nobody interned cannot be a channel.
+*/
+Channel*    ChannelRegistry::getChannel(const std::string& name)
+{
+    char    folded[CHANNELLEN];
+
+    if (name.empty() || name.length() > CHANNELLEN)
+        return (NULL);
+    CaseMapping::fold(name.data(), name.length(), folded);
+
+    Atom    atom = AtomTable::instance().find(folded, name.length());
+    if (atom == NO_ATOM)
+        return (NULL);
+
+    size_t  i = findSlot(atom);
+    if (_nameSlots[i].handle == INVALID_CHANNEL)
+        return (NULL);
+    return (_channels[_nameSlots[i].handle]);
+}
+
+Channel*    ChannelRegistry::getChannel(ChannelHandle handle)
+{
+    if (handle >= _channels.size())
+        return (NULL);
+    return (_channels[handle]);
+}
+
+/*
+** eraseName(const Channel& channel) [PRIVATE]
+** Frees the channel's name slot and shifts the rest of its cluster
+** back (see UserRegistry::eraseNick()).
+*/
+void    ChannelRegistry::eraseName(const Channel& channel)
+{
+    size_t  mask = _nameSlots.size() - 1;
+    size_t  hole = findSlot(AtomTable::instance().folded(channel.getNameAtom()));
+
+    if (_nameSlots[hole].handle == INVALID_CHANNEL)
+        return ;
+    for (size_t j = (hole + 1) & mask; _nameSlots[j].handle != INVALID_CHANNEL; j = (j + 1) & mask)
+    {
+        size_t  home = _nameSlots[j].hash & mask;
+        bool    stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+        if (stays)
+            continue ;
+        _nameSlots[hole] = _nameSlots[j];
+        hole = j;
+    }
+    _nameSlots[hole].handle = INVALID_CHANNEL;
+}
+
+/*
+** growNameTable() [PRIVATE]
+** Doubles the name table and re-inserts every entry (hashes are cached).
+*/
+void    ChannelRegistry::growNameTable()
+{
+    std::vector<NameSlot>   old;
+    NameSlot                empty = { 0, INVALID_CHANNEL };
+
+    old.swap(_nameSlots);
+    _nameSlots.assign(old.size() * 2, empty);
+
+    size_t  mask = _nameSlots.size() - 1;
+    for (size_t i = 0; i < old.size(); i++)
+    {
+        if (old[i].handle == INVALID_CHANNEL)
+            continue ;
+        size_t  j = old[i].hash & mask;
+        while (_nameSlots[j].handle != INVALID_CHANNEL)
+            j = (j + 1) & mask;
+        _nameSlots[j] = old[i];
+    }
+}
+
+/*
+** removeChannel(ChannelHandle handle)
+** Destroys the channel; its handle goes back to the free list. Members'
+** Client::_channels entries are the caller's business.
+*/
+void    ChannelRegistry::removeChannel(ChannelHandle handle)
+{
+    Channel* channel = getChannel(handle);
+    if (channel == NULL)
+        return ;
+
+    eraseName(*channel);
+    _channels[handle] = NULL;
+    _freeHandles.push_back(handle);
+    _channelCount--;
+    delete channel;
+}
+
+/*
+** removeUserFromAll(Client* client)
+** Takes the client out of every channel it is in (quit); channels left
+** empty are destroyed.
+*/
+void    ChannelRegistry::removeUserFromAll(Client* client)
+{
+    const std::vector<ChannelHandle>&   joined = client->getChannels();
+
+    for (size_t i = 0; i < joined.size(); i++)
+    {
+        Channel* channel = getChannel(joined[i]);
+        if (channel == NULL)
+            continue ;
+        channel->removeMember(client->getHandle());
+        if (channel->getMemberCount() == 0)
+            removeChannel(joined[i]);
+    }
+    client->leaveAllChannels();
+}
+
+size_t  ChannelRegistry::getChannelCount() const
+{
+    return (_channelCount);
+}
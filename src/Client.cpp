@@ -0,0 +1,247 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Client.cpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:12:40 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 09:12:40 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/Client.hpp"
+#include <algorithm>
+
+Client::Client(int fd, ClientHandle handle)
+    : _fd(fd), _handle(handle), _nickname(NO_ATOM), _hostname(NO_ATOM), _state(CONNECTING),
+    _paswordVerified(false), _isOperator(false), _timer(NO_TIMER), _lastActivity(0),
+    _pingSentAt(0) {}
+
+Client::~Client()
+{
+    AtomTable::instance().release(_nickname);
+    AtomTable::instance().release(_hostname);
+}
+
+int Client::getFd() const
+{
+    return (_fd);
+}
+
+/*
+** getHandle()
+** What deferred work (channel membership, timers) keeps instead of the
+** fd or a pointer, see ClientPool.
+*/
+ClientHandle    Client::getHandle() const
+{
+    return (_handle);
+}
+
+ClientState Client::getState() const
+{
+    return (_state);
+}
+
+const std::string&  Client::getNickname() const
+{
+    return (AtomTable::instance().text(_nickname));
+}
+
+const std::string&  Client::getUsername() const
+{
+    return (_username);
+}
+
+const std::string&  Client::getRealname() const
+{
+    return (_realname);
+}
+
+const std::string&  Client::getHostname() const
+{
+    return (AtomTable::instance().text(_hostname));
+}
+
+Atom    Client::getNicknameAtom() const
+{
+    return (_nickname);
+}
+
+Atom    Client::getHostnameAtom() const
+{
+    return (_hostname);
+}
+
+bool    Client::isPasswordVerified() const
+{
+    return (_paswordVerified);
+}
+
+bool    Client::isOperator() const
+{
+    return (_isOperator);
+}
+
+void    Client::setUsername(const std::string& username)
+{
+    _username = username;
+    renderPrefix();
+}
+
+/*
+** setNickname(const std::string& nickname)
+** Nicknames and hostnames are interned: the client holds a reference to
+** a shared AtomTable entry, not its own copy.
+*/
+void    Client::setNickname(const std::string& nickname)
+{
+    Atom    atom = AtomTable::instance().intern(nickname);
+
+    AtomTable::instance().release(_nickname);
+    _nickname = atom;
+    renderPrefix();
+}
+
+void    Client::setRealname(const std::string& realname)
+{
+    _realname = realname;
+}
+
+void    Client::setHostname(const std::string& hostname)
+{
+    Atom    atom = AtomTable::instance().intern(hostname);
+
+    AtomTable::instance().release(_hostname);
+    _hostname = atom;
+    renderPrefix();
+}
+
+void    Client::setState(ClientState state)
+{
+    _state = state;
+}
+
+void    Client::setPasswordVerified(bool verified)
+{
+    _paswordVerified = verified;
+}
+
+void    Client::setOperator(bool isOp)
+{
+    _isOperator = isOp;
+}
+
+/*
+** joinChannel(ChannelHandle channel)
+** Channels the client is in, as registry handles (a client is in a
+** handful of channels: a small vector beats a tree).
+*/
+void    Client::joinChannel(ChannelHandle channel)
+{
+    if (!isInChannel(channel))
+        _channels.push_back(channel);
+}
+
+void    Client::leaveChannel(ChannelHandle channel)
+{
+    std::vector<ChannelHandle>::iterator it = std::find(_channels.begin(), _channels.end(), channel);
+    if (it == _channels.end())
+        return ;
+    *it = _channels.back();
+    _channels.pop_back();
+}
+
+void    Client::leaveAllChannels()
+{
+    _channels.clear();
+}
+
+bool    Client::isInChannel(ChannelHandle channel) const
+{
+    return (std::find(_channels.begin(), _channels.end(), channel) != _channels.end());
+}
+
+const std::vector<ChannelHandle>&   Client::getChannels() const
+{
+    return (_channels);
+}
+
+/*
+** renderPrefix() [PRIVATE]
+** Rebuilds the cached prefix; nick, user and host change rarely, relayed
+** messages are frequent.
+*/
+void    Client::renderPrefix()
+{
+    const std::string&  nick = getNickname();
+    const std::string&  host = getHostname();
+
+    _prefix.clear();
+    _prefix.reserve(nick.length() + _username.length() + host.length() + 2);
+    _prefix += nick;
+    _prefix += '!';
+    _prefix += _username;
+    _prefix += '@';
+    _prefix += host;
+}
+
+/*
+** getPrefix()
+** Source prefix for messages relayed on behalf of this client.
+**
+** Format: nick!user@host
+*/
+const std::string&  Client::getPrefix() const
+{
+    return (_prefix);
+}
+
+/*
+** getReplyTarget()
+** Target of numeric replies: the nickname, "*" until the client has one.
+*/
+const std::string&  Client::getReplyTarget() const
+{
+    static const std::string noNickname("*");
+
+    if (_nickname == NO_ATOM)
+        return (noNickname);
+    return (getNickname());
+}
+
+/*
+** Keepalive bookkeeping, driven by the event loop (see Reactor): the
+** timer is the client's single deadline in the loop's TimerWheel, what
+** it means depends on the state (registration, idle, PONG wait).
+*/
+TimerId Client::getTimer() const
+{
+    return (_timer);
+}
+
+unsigned long   Client::getLastActivity() const
+{
+    return (_lastActivity);
+}
+
+unsigned long   Client::getPingSentAt() const
+{
+    return (_pingSentAt);
+}
+
+void    Client::setTimer(TimerId timer)
+{
+    _timer = timer;
+}
+
+void    Client::setLastActivity(unsigned long now)
+{
+    _lastActivity = now;
+}
+
+void    Client::setPingSentAt(unsigned long now)
+{
+    _pingSentAt = now;
+}
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ClientPool.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:10:37 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 22:10:37 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/ClientPool.hpp"
+#include "../inc/Client.hpp"
+#include <new>
+
+ClientPool::ClientPool()
+    : _freeHead(CLIENT_INDEX_MASK), _freeTail(CLIENT_INDEX_MASK), _live(0) {}
+
+ClientPool::~ClientPool()
+{
+    for (size_t i = 0; i < _slots.size(); i++)
+        if (_slots[i].live)
+            slot(i)->~Client();
+    for (size_t i = 0; i < _slabs.size(); i++)
+        ::operator delete(_slabs[i]);
+}
+
+/*
+** create(int fd)
+** Constructs a Client for fd in a free slot, growing the pool by one
+** slab when there is none.
+**
+** Returns: its handle, INVALID_CLIENT when the index space is exhausted
+*/
+ClientHandle    ClientPool::create(int fd)
+{
+    if (_freeHead == CLIENT_INDEX_MASK && !grow())
+        return (INVALID_CLIENT);
+
+    unsigned int    index = _freeHead;
+    Slot&           entry = _slots[index];
+
+    _freeHead = entry.nextFree;
+    if (_freeHead == CLIENT_INDEX_MASK)
+        _freeTail = CLIENT_INDEX_MASK;
+    entry.live = true;
+    _live++;
+
+    ClientHandle handle = (entry.generation << CLIENT_INDEX_BITS) | index;
+    new (slot(index)) Client(fd, handle);
+    return (handle);
+}
+
+/*
+** destroy(ClientHandle handle)
+** Destroys the client and queues its slot at the end of the free list.
+** A stale or invalid handle is ignored.
+*/
+void    ClientPool::destroy(ClientHandle handle)
+{
+    Client* client = get(handle);
+    if (client == NULL)
+        return ;
+
+    unsigned int    index = handle & CLIENT_INDEX_MASK;
+    Slot&           entry = _slots[index];
+
+    client->~Client();
+    entry.live = false;
+    entry.generation = (entry.generation + 1) & CLIENT_GENERATION_MASK;
+    if (entry.generation == 0)
+        entry.generation = 1;
+    entry.nextFree = CLIENT_INDEX_MASK;
+    if (_freeTail == CLIENT_INDEX_MASK)
+        _freeHead = index;
+    else
+        _slots[_freeTail].nextFree = index;
+    _freeTail = index;
+    _live--;
+}
+
+/*
+** get(ClientHandle handle)
+** Returns: the client, NULL if the handle is stale (client destroyed)
+**          or invalid
+*/
+Client* ClientPool::get(ClientHandle handle)
+{
+    unsigned int index = handle & CLIENT_INDEX_MASK;
+
+    if (index >= _slots.size())
+        return (NULL);
+    const Slot& entry = _slots[index];
+    if (!entry.live || entry.generation != (handle >> CLIENT_INDEX_BITS))
+        return (NULL);
+    return (slot(index));
+}
+
+size_t  ClientPool::size() const
+{
+    return (_live);
+}
+
+/*
+** slot(unsigned int index) [PRIVATE]
+** Storage of slot index: slabs are raw arrays of Client objects.
+*/
+Client* ClientPool::slot(unsigned int index)
+{
+    return (reinterpret_cast<Client*>(_slabs[index / CLIENT_SLAB_SIZE])
+        + index % CLIENT_SLAB_SIZE);
+}
+
+/*
+** grow() [PRIVATE]
+** Adds a slab and chains its slots onto the (empty) free list.
+**
+** Returns: false once every index has been handed out
+*/
+bool    ClientPool::grow()
+{
+    size_t first = _slots.size();
+    if (first + CLIENT_SLAB_SIZE > CLIENT_INDEX_MASK)
+        return (false);
+
+    _slabs.push_back(static_cast<char*>(::operator new(sizeof(Client) * CLIENT_SLAB_SIZE)));
+    Slot    entry;
+    entry.generation = 1;
+    entry.live = false;
+    for (size_t i = first; i < first + CLIENT_SLAB_SIZE; i++)
+    {
+        entry.nextFree = (i + 1 < first + CLIENT_SLAB_SIZE) ? i + 1 : CLIENT_INDEX_MASK;
+        _slots.push_back(entry);
+    }
+    _freeHead = first;
+    _freeTail = first + CLIENT_SLAB_SIZE - 1;
+    return (true);
+}
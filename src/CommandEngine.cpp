@@ -10,4 +10,296 @@
 /*                                                                            */
 /* ************************************************************************** */
 
-// TODO @yitani
\ No newline at end of file
+#include "../inc/CommandEngine.hpp"
+#include "../inc/ReplyBuilder.hpp"
+#include <cctype>
+
+#define MAX_COMMAND_LENGTH 32
+
+/*
+** matchRest(const char* name, const char* upper, size_t length)
+** Compares name[1..length) to an uppercase, letters-only literal,
+** ignoring case: c & 0xDF lands on 'A'..'Z' only for ASCII letters.
+*/
+static inline bool  matchRest(const char* name, const char* upper, size_t length)
+{
+    for (size_t i = 1; i < length; i++)
+        if ((name[i] & 0xDF) != upper[i])
+            return (false);
+    return (true);
+}
+
+/*
+** lookup(const char* name, size_t length)
+** Resolves a command token to its CommandId without copying or
+** uppercasing it: switch on the length, then on the folded first
+** letter, then one case-insensitive compare per candidate (at most
+** four, for 4-letter commands starting with P: tried by frequency,
+** the keepalives first and PASS, sent once per connection, last).
+** Keep in sync with enum CommandId and name().
+**
+** Returns: CommandId, CMD_UNKNOWN if not a built-in command
+*/
+CommandId   CommandEngine::lookup(const char* name, size_t length)
+{
+    if (length < 3 || length > 7)
+        return (CMD_UNKNOWN);
+
+    char    first = name[0] & 0xDF;
+
+    switch (length)
+    {
+        case 3:
+            if (first == 'W' && matchRest(name, "WHO", 3))
+                return (CMD_WHO);
+            break ;
+        case 4:
+            switch (first)
+            {
+                case 'P':
+                    if (matchRest(name, "PING", 4))
+                        return (CMD_PING);
+                    if (matchRest(name, "PONG", 4))
+                        return (CMD_PONG);
+                    if (matchRest(name, "PART", 4))
+                        return (CMD_PART);
+                    if (matchRest(name, "PASS", 4))
+                        return (CMD_PASS);
+                    break ;
+                case 'N':
+                    if (matchRest(name, "NICK", 4))
+                        return (CMD_NICK);
+                    break ;
+                case 'U':
+                    if (matchRest(name, "USER", 4))
+                        return (CMD_USER);
+                    break ;
+                case 'Q':
+                    if (matchRest(name, "QUIT", 4))
+                        return (CMD_QUIT);
+                    break ;
+                case 'J':
+                    if (matchRest(name, "JOIN", 4))
+                        return (CMD_JOIN);
+                    break ;
+                case 'K':
+                    if (matchRest(name, "KICK", 4))
+                        return (CMD_KICK);
+                    break ;
+                case 'M':
+                    if (matchRest(name, "MODE", 4))
+                        return (CMD_MODE);
+                    break ;
+                case 'L':
+                    if (matchRest(name, "LIST", 4))
+                        return (CMD_LIST);
+                    break ;
+            }
+            break ;
+        case 5:
+            if (first == 'T' && matchRest(name, "TOPIC", 5))
+                return (CMD_TOPIC);
+            if (first == 'N' && matchRest(name, "NAMES", 5))
+                return (CMD_NAMES);
+            if (first == 'S' && matchRest(name, "STATS", 5))
+                return (CMD_STATS);
+            break ;
+        case 6:
+            if (first == 'I' && matchRest(name, "INVITE", 6))
+                return (CMD_INVITE);
+            if (first == 'N' && matchRest(name, "NOTICE", 6))
+                return (CMD_NOTICE);
+            break ;
+        case 7:
+            if (first == 'P' && matchRest(name, "PRIVMSG", 7))
+                return (CMD_PRIVMSG);
+            break ;
+    }
+    return (CMD_UNKNOWN);
+}
+
+/*
+** name(CommandId id)
+** Returns: the command's name, "OTHER" for CMD_UNKNOWN (commands
+**          registered at runtime, unknown ones)
+*/
+const char* CommandEngine::name(CommandId id)
+{
+    static const char*  names[CMD_COUNT + 1] = {
+        "PASS", "NICK", "USER", "QUIT", "PING", "PONG", "JOIN", "PART", "KICK",
+        "INVITE", "TOPIC", "MODE", "PRIVMSG", "NOTICE", "NAMES", "LIST", "WHO",
+        "STATS", "OTHER"
+    };
+
+    if (id < 0 || id > CMD_COUNT)
+        return (names[CMD_UNKNOWN]);
+    return (names[id]);
+}
+
+/*
+** isNumeric(const StringSlice& command)
+** Numeric replies are 3 digits; they are never commands.
+*/
+static inline bool  isNumeric(const StringSlice& command)
+{
+    return (command.length == 3
+        && (unsigned)(command.data[0] - '0') < 10
+        && (unsigned)(command.data[1] - '0') < 10
+        && (unsigned)(command.data[2] - '0') < 10);
+}
+
+CommandEngine::CommandEngine(NetworkManager& networkManager)
+    : _networkManager(networkManager), _metrics(networkManager.getMetrics())
+{
+    for (int i = 0; i < CMD_COUNT; i++)
+        _handlers[i] = NULL;
+}
+
+CommandEngine::~CommandEngine()
+{
+    for (int i = 0; i < CMD_COUNT; i++)
+        delete _handlers[i];
+    for (std::map<std::string, ICommand*>::iterator it = _extraHandlers.begin();
+            it != _extraHandlers.end(); ++it)
+        delete it->second;
+}
+
+/*
+** registerCommand(const std::string& name, ICommand* handler)
+** Binds a command name to its handler, taking ownership. Built-in
+** names fill their CommandId slot, anything else is kept (uppercased)
+** in _extraHandlers. Re-registering a name replaces and frees the
+** previous handler.
+*/
+void    CommandEngine::registerCommand(const std::string& name, ICommand* handler)
+{
+    CommandId   id = lookup(name.data(), name.length());
+    if (id != CMD_UNKNOWN)
+    {
+        if (_handlers[id] != handler)
+            delete _handlers[id];
+        _handlers[id] = handler;
+        return ;
+    }
+
+    std::string key = name;
+    for (size_t i = 0; i < key.length(); i++)
+        key[i] = std::toupper(static_cast<unsigned char>(key[i]));
+
+    std::map<std::string, ICommand*>::iterator it = _extraHandlers.find(key);
+    if (it != _extraHandlers.end())
+    {
+        if (it->second != handler)
+            delete it->second;
+        it->second = handler;
+    }
+    else
+        _extraHandlers[key] = handler;
+}
+
+/*
+** findHandler(const StringSlice& command, CommandId& id) [PRIVATE]
+** Built-in commands come straight from the switch. Only names it does
+** not know are uppercased into a stack buffer and looked up in
+** _extraHandlers (skipped entirely while none are registered).
+** id receives the CommandId (CMD_UNKNOWN for _extraHandlers).
+**
+** Returns: handler, NULL for unknown or absurdly long commands
+*/
+ICommand*   CommandEngine::findHandler(const StringSlice& command, CommandId& id)
+{
+    id = lookup(command.data, command.length);
+    if (id != CMD_UNKNOWN)
+        return (_handlers[id]);
+    if (_extraHandlers.empty())
+        return (NULL);
+
+    char    upper[MAX_COMMAND_LENGTH];
+
+    if (command.length == 0 || command.length >= MAX_COMMAND_LENGTH)
+        return (NULL);
+    for (size_t i = 0; i < command.length; i++)
+        upper[i] = std::toupper(static_cast<unsigned char>(command.data[i]));
+
+    std::map<std::string, ICommand*>::iterator it =
+        _extraHandlers.find(std::string(upper, command.length));
+    if (it == _extraHandlers.end())
+        return (NULL);
+    return (it->second);
+}
+
+/*
+** resolve(Client* client, const StringSlice& command, CommandId& id) [PRIVATE]
+** Finds the handler a client may run, answering errors itself:
+** - numeric reply (3 digits) → dropped silently, clients may not send them
+** - unknown command → 421 ERR_UNKNOWNCOMMAND (registered clients only)
+** - command needing registration → 451 ERR_NOTREGISTERED
+** Every command is counted in the loop's metrics under its id.
+**
+** Returns: handler to run, NULL if the message is answered/ignored
+*/
+ICommand*   CommandEngine::resolve(Client* client, const StringSlice& command, CommandId& id)
+{
+    id = CMD_UNKNOWN;
+    if (isNumeric(command))
+        return (NULL);
+
+    ICommand*   handler = findHandler(command, id);
+    counterAdd(_metrics.commands[id], 1);
+
+    if (handler == NULL)
+    {
+        if (client->getState() == REGISTERED)
+            ReplyBuilder(_networkManager, client->getFd()).numeric(421, client->getNickname())
+                .param(command).trailing("Unknown command").send();
+        return (NULL);
+    }
+    if (handler->requiresAuth() && client->getState() != REGISTERED)
+    {
+        ReplyBuilder(_networkManager, client->getFd())
+            .numeric(451, client->getReplyTarget()).trailing("You have not registered").send();
+        return (NULL);
+    }
+    return (handler);
+}
+
+/*
+** execute(Client* client, const IRCMessageView& message)
+** Hot path: dispatches a view straight from the receive buffer,
+** without building an owning IRCMessage. The handler's run time goes
+** to its command's histogram (two clock reads per command).
+*/
+void    CommandEngine::execute(Client* client, const IRCMessageView& message)
+{
+    if (client == NULL)
+        return ;
+
+    CommandId   id;
+    ICommand*   handler = resolve(client, message.command, id);
+    if (handler == NULL)
+        return ;
+    TRACE_SCOPE(trace, TRACE_COMMAND, client->getFd(), id, client->getHandle());
+    unsigned long start = Metrics::clock();
+    handler->executeView(client, message);
+    _metrics.commandTime[id].record(Metrics::clock() - start);
+}
+
+/*
+** execute(Client* client, const IRCMessage& message)
+** Owning variant, for messages that were stored or built by hand.
+*/
+void    CommandEngine::execute(Client* client, const IRCMessage& message)
+{
+    if (client == NULL)
+        return ;
+
+    StringSlice command(message.command.data(), message.command.length());
+    CommandId   id;
+    ICommand*   handler = resolve(client, command, id);
+    if (handler == NULL)
+        return ;
+    TRACE_SCOPE(trace, TRACE_COMMAND, client->getFd(), id, client->getHandle());
+    unsigned long start = Metrics::clock();
+    handler->execute(client, message);
+    _metrics.commandTime[id].record(Metrics::clock() - start);
+}
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConnectionTable.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 11:24:37 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 11:24:37 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/ConnectionTable.hpp"
+#include <algorithm>
+
+Connection::Connection()
+    : fd(-1), peerAddr(0), wantWrite(false), closing(false), dirty(false), readPending(false),
+    discarding(false), throttled(false), floodExempt(false), floodTokens(0),
+    floodStamp(0), writeOffset(0), sendQBytes(0), queuedAt(0), sendInFlight(false) {}
+
+/*
+** swap(Connection& other)
+** Exchanges two records without copying buffer contents (C++98 has no
+** move, but string/deque swap only exchanges internal pointers).
+*/
+void    Connection::swap(Connection& other)
+{
+    std::swap(fd, other.fd);
+    std::swap(peerAddr, other.peerAddr);
+    std::swap(wantWrite, other.wantWrite);
+    std::swap(closing, other.closing);
+    std::swap(dirty, other.dirty);
+    std::swap(readPending, other.readPending);
+    std::swap(discarding, other.discarding);
+    std::swap(throttled, other.throttled);
+    std::swap(floodExempt, other.floodExempt);
+    std::swap(floodTokens, other.floodTokens);
+    std::swap(floodStamp, other.floodStamp);
+    readBuffer.swap(other.readBuffer);
+    writeQueue.swap(other.writeQueue);
+    std::swap(writeOffset, other.writeOffset);
+    std::swap(sendQBytes, other.sendQBytes);
+    std::swap(queuedAt, other.queuedAt);
+    std::swap(sendInFlight, other.sendInFlight);
+    overflow.swap(other.overflow);
+}
+
+ConnectionTable::ConnectionTable() {}
+
+ConnectionTable::~ConnectionTable() {}
+
+/*
+** add(int fd)
+** Appends a fresh record for fd and indexes it.
+**
+** Returns: the new record (valid until the next add/remove)
+*/
+Connection* ConnectionTable::add(int fd)
+{
+    if (fd < 0)
+        return (NULL);
+    if (fd >= (int)_slotByFd.size())
+        _slotByFd.resize(fd + 1, -1);
+    if (_slotByFd[fd] != -1)
+        return (&_connections[_slotByFd[fd]]);
+
+    if (_connections.size() == _connections.capacity())
+        grow();
+    _slotByFd[fd] = _connections.size();
+    _connections.push_back(Connection());
+    _connections.back().fd = fd;
+    return (&_connections.back());
+}
+
+/*
+** grow() [PRIVATE]
+** Doubles the capacity. A vector growing by itself would copy-construct
+** every live record (C++98 has no move): its receive ring, write queue
+** and overflow, on each doubling of a connect storm. Here the records
+** are swapped into default ones instead, which only exchanges pointers.
+*/
+void    ConnectionTable::grow()
+{
+    std::vector<Connection> larger;
+
+    larger.reserve(std::max((size_t)CONNECTION_TABLE_MIN, _connections.capacity() * 2));
+    larger.resize(_connections.size());
+    for (size_t i = 0; i < _connections.size(); i++)
+        larger[i].swap(_connections[i]);
+    _connections.swap(larger);
+}
+
+/*
+** find(int fd)
+** Returns: record for fd, NULL if fd is not a live connection
+*/
+Connection* ConnectionTable::find(int fd)
+{
+    if (fd < 0 || fd >= (int)_slotByFd.size() || _slotByFd[fd] == -1)
+        return (NULL);
+    return (&_connections[_slotByFd[fd]]);
+}
+
+/*
+** remove(int fd)
+** Swap-removes fd's record: the last record takes its slot and the
+** index entry of the moved fd is patched.
+*/
+void    ConnectionTable::remove(int fd)
+{
+    if (fd < 0 || fd >= (int)_slotByFd.size() || _slotByFd[fd] == -1)
+        return ;
+
+    size_t slot = _slotByFd[fd];
+    size_t last = _connections.size() - 1;
+    if (slot != last)
+    {
+        _connections[slot].swap(_connections[last]);
+        _slotByFd[_connections[slot].fd] = slot;
+    }
+    _connections.pop_back();
+    _slotByFd[fd] = -1;
+}
+
+size_t  ConnectionTable::size() const
+{
+    return (_connections.size());
+}
+
+Connection& ConnectionTable::at(size_t slot)
+{
+    return (_connections[slot]);
+}
@@ -0,0 +1,216 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HostLimiter.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 21:04:12 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 21:04:12 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/HostLimiter.hpp"
+#include <arpa/inet.h>  // ntohl
+#include <algorithm>
+
+HostLimiter::HostLimiter()
+    : _table(HOST_TABLE_MIN), _bits(0), _used(0), _maxActive(HOST_MAX_CONNECTIONS),
+    _burst(HOST_CONNECT_BURST), _refillMs(HOST_CONNECT_REFILL_MS)
+{
+    for (size_t i = 0; i < _table.size(); i++)
+        _table[i].addr = 0;
+    while (((size_t)1 << _bits) < _table.size())
+        _bits++;
+}
+
+/*
+** admit(uint32_t addr, unsigned long nowMs)
+** Accounts one accepted connection from addr (network order), unless
+** the host is over one of its limits. An admitted connection must be
+** release()d when it closes; a refused one must not.
+** A refused attempt spends no token: a host hammering the port gets
+** back in as soon as its bucket refills.
+**
+** Returns: HOST_ADMIT, or why the connection must be refused
+*/
+HostVerdict HostLimiter::admit(uint32_t addr, unsigned long nowMs)
+{
+    if (isExempt(addr))
+        return (HOST_ADMIT);
+
+    Entry* entry = find(addr);
+    if (entry == NULL)
+        entry = insert(addr, nowMs);
+    if (_maxActive != 0 && entry->active >= _maxActive)
+        return (HOST_TOO_MANY);
+    if (_burst != 0)
+    {
+        refill(*entry, nowMs);
+        if (entry->tokens == 0)
+            return (HOST_TOO_FAST);
+        entry->tokens--;
+    }
+    entry->active++;
+    return (HOST_ADMIT);
+}
+
+/*
+** release(uint32_t addr)
+** An admitted connection from addr closed.
+*/
+void    HostLimiter::release(uint32_t addr)
+{
+    Entry* entry = find(addr);
+    if (entry != NULL && entry->active > 0)
+        entry->active--;
+}
+
+/*
+** setLimits(unsigned int maxActive, unsigned int burst, unsigned long refillMs)
+** 0 disables the matching limit (concurrent connections, or the rate).
+*/
+void    HostLimiter::setLimits(unsigned int maxActive, unsigned int burst,
+            unsigned long refillMs)
+{
+    _maxActive = std::min(maxActive, 0xFFFFu);
+    _burst = std::min(burst, 0xFFFFu);
+    _refillMs = (refillMs == 0) ? 1 : refillMs;
+}
+
+unsigned int    HostLimiter::getActive(uint32_t addr)
+{
+    Entry* entry = find(addr);
+    return (entry == NULL ? 0 : entry->active);
+}
+
+size_t  HostLimiter::size() const
+{
+    return (_used);
+}
+
+/*
+** isExempt(uint32_t addr) [STATIC]
+** True for loopback addresses, which are never limited.
+*/
+bool    HostLimiter::isExempt(uint32_t addr)
+{
+    return ((ntohl(addr) >> 24) == 127);
+}
+
+/*
+** slotOf(uint32_t addr) const [PRIVATE]
+** Multiplicative (Fibonacci) hashing on the host-order address, keeping
+** the top _bits bits of the product: those depend on every bit of the
+** address, so neighbouring addresses, a /24 scanning us, land far apart
+** and probe runs stay short. (The low bits of the product never see
+** the high bits of the address.)
+*/
+size_t  HostLimiter::slotOf(uint32_t addr) const
+{
+    return ((uint32_t)(ntohl(addr) * 2654435769u) >> (32 - _bits));
+}
+
+HostLimiter::Entry* HostLimiter::find(uint32_t addr)
+{
+    size_t mask = _table.size() - 1;
+
+    for (size_t i = slotOf(addr); _table[i].addr != 0; i = (i + 1) & mask)
+        if (_table[i].addr == addr)
+            return (&_table[i]);
+    return (NULL);
+}
+
+/*
+** insert(uint32_t addr, unsigned long nowMs) [PRIVATE]
+** New entry for addr (not in the table), with a full bucket. The table
+** is kept at most half full.
+*/
+HostLimiter::Entry* HostLimiter::insert(uint32_t addr, unsigned long nowMs)
+{
+    if ((_used + 1) * 2 > _table.size())
+        grow(nowMs);
+
+    size_t mask = _table.size() - 1;
+    size_t i = slotOf(addr);
+    while (_table[i].addr != 0)
+        i = (i + 1) & mask;
+    _table[i].addr = addr;
+    _table[i].active = 0;
+    _table[i].tokens = _burst;
+    _table[i].stamp = nowMs;
+    _used++;
+    return (&_table[i]);
+}
+
+/*
+** refill(Entry& entry, unsigned long nowMs) [PRIVATE]
+** Credits the tokens earned since the last refill, capped at the burst.
+** When reactors share the limiter each passes its own cycle clock, which
+** may lag the one that last stamped the entry: a time at or before the
+** stamp has earned nothing (the unsigned difference would wrap instead).
+*/
+void    HostLimiter::refill(Entry& entry, unsigned long nowMs) const
+{
+    if (nowMs <= entry.stamp)
+        return ;
+
+    unsigned long earned = (nowMs - entry.stamp) / _refillMs;
+
+    if (earned == 0)
+        return ;
+    if (entry.tokens + earned >= _burst)
+    {
+        entry.tokens = _burst;
+        entry.stamp = nowMs;
+    }
+    else
+    {
+        entry.tokens += earned;
+        entry.stamp += earned * _refillMs;
+    }
+}
+
+/*
+** grow(unsigned long nowMs) [PRIVATE]
+** Rehashes the live entries, dropping the idle ones (no connection and
+** a refilled bucket: nothing to remember). The table only doubles when
+** what is left would still fill more than a quarter of it.
+*/
+void    HostLimiter::grow(unsigned long nowMs)
+{
+    std::vector<Entry> old;
+    old.swap(_table);
+
+    size_t live = 0;
+    for (size_t i = 0; i < old.size(); i++)
+    {
+        if (old[i].addr == 0)
+            continue ;
+        refill(old[i], nowMs);
+        if (old[i].active != 0 || old[i].tokens < _burst)
+            live++;
+    }
+    size_t capacity = old.size();
+    if (live * 4 > capacity)
+    {
+        capacity *= 2;
+        _bits++;
+    }
+
+    _table.resize(capacity);
+    for (size_t i = 0; i < capacity; i++)
+        _table[i].addr = 0;
+    _used = 0;
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < old.size(); i++)
+    {
+        if (old[i].addr == 0 || (old[i].active == 0 && old[i].tokens >= _burst))
+            continue ;
+        size_t j = slotOf(old[i].addr);
+        while (_table[j].addr != 0)
+            j = (j + 1) & mask;
+        _table[j] = old[i];
+        _used++;
+    }
+}
@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   IEventBackend.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:14:20 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 10:14:20 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/IEventBackend.hpp"
+#include "../inc/backends/PollBackend.hpp"
+#include "../inc/backends/EpollBackend.hpp"
+#include "../inc/backends/UringBackend.hpp"
+#include <stdexcept>
+
+/*
+** create(EventBackendType type)
+** Instantiates the requested readiness backend.
+** EVENT_BACKEND_DEFAULT resolves to epoll on Linux and poll elsewhere;
+** asking for epoll on a platform without it falls back to poll, and
+** io_uring falls back to epoll when the kernel cannot set up the ring
+** (too old, disabled by sysctl or seccomp).
+**
+** Returns: heap-allocated backend, owned by the caller
+*/
+IEventBackend*  IEventBackend::create(EventBackendType type)
+{
+#ifdef __linux__
+    if (type == EVENT_BACKEND_URING)
+    {
+        try
+        {
+            return (new UringBackend());
+        }
+        catch (std::runtime_error&)
+        {
+            type = EVENT_BACKEND_EPOLL;
+        }
+    }
+    if (type == EVENT_BACKEND_DEFAULT || type == EVENT_BACKEND_EPOLL)
+        return (new EpollBackend());
+#else
+    (void)type;
+#endif
+    return (new PollBackend());
+}
@@ -11,11 +11,280 @@
 /* ************************************************************************** */
 
 #include "../inc/IRCServer.hpp"
+#include <errno.h>
 
-IRCServer::IRCServer(int port, const std::string password) : _port(port), _password(password)
+IRCServer*  IRCServer::_instance = NULL;
+
+IRCServer::IRCServer(int port, const std::string password)
+    : _port(port), _password(password), _running(false), _motdGeneration(0),
+    _traceGeneration(0), _reactorCount(1), _backend(EVENT_BACKEND_DEFAULT), _floodControl(true),
+    _startTime(std::time(NULL)), _metricsEndpoint(NULL), _shards(NULL)
 {
     if (port <= 0 || port > 65535)
         throw std::runtime_error("Port must be between 1 and 65535");
     if (password.empty())
         throw std::runtime_error("Password cannot be empty");
-}
\ No newline at end of file
+    pthread_mutex_init(&_stateLock, NULL);
+}
+
+/*
+** ~IRCServer()
+** Loops go first (they close their sockets), then the shard plumbing.
+** Registries are destroyed last, with the members.
+*/
+IRCServer::~IRCServer()
+{
+    if (_instance == this)
+        _instance = NULL;
+    delete _metricsEndpoint;
+    for (size_t i = 0; i < _reactors.size(); i++)
+        delete _reactors[i];
+    delete _shards;
+    pthread_mutex_destroy(&_stateLock);
+}
+
+/*
+** setReactorCount(unsigned int count)
+** Number of event loops, 1 (default) to MAX_REACTORS. Must be called
+** before initialize().
+*/
+void    IRCServer::setReactorCount(unsigned int count)
+{
+    if (count == 0 || count > MAX_REACTORS)
+        throw std::runtime_error("Reactor count must be between 1 and 64");
+    _reactorCount = count;
+}
+
+/*
+** setEventBackend(const std::string& name)
+** Event backend of every loop: "epoll", "poll" or "uring" (io_uring,
+** which falls back to epoll on kernels that cannot run it). Must be
+** called before initialize().
+*/
+void    IRCServer::setEventBackend(const std::string& name)
+{
+    if (name == "epoll")
+        _backend = EVENT_BACKEND_EPOLL;
+    else if (name == "poll")
+        _backend = EVENT_BACKEND_POLL;
+    else if (name == "uring" || name == "io_uring")
+        _backend = EVENT_BACKEND_URING;
+    else
+        throw std::runtime_error("Unknown event backend: " + name);
+}
+
+/*
+** setFloodControl(bool enabled)
+** RFC 1459 inbound flood control in every loop (on by default). Off is
+** for load testing (bench/ircbench) only: one client may then send as
+** fast as the loop reads. Must be called before initialize().
+*/
+void    IRCServer::setFloodControl(bool enabled)
+{
+    _floodControl = enabled;
+}
+
+bool    IRCServer::isFloodControlEnabled() const
+{
+    return (_floodControl);
+}
+
+/*
+** setMetricsSocket(const std::string& path)
+** Serves the metrics scrape endpoint on the AF_UNIX socket path while
+** the server runs (see MetricsEndpoint). Call before run().
+*/
+void    IRCServer::setMetricsSocket(const std::string& path)
+{
+    delete _metricsEndpoint;
+    _metricsEndpoint = new MetricsEndpoint(*this, path);
+}
+
+/*
+** collectMetrics(Metrics& total)
+** Adds every event loop's metrics to total, from any thread and
+** without locking: the loops keep running while they are read.
+*/
+void    IRCServer::collectMetrics(Metrics& total)
+{
+    for (size_t i = 0; i < _reactors.size(); i++)
+        _reactors[i]->getMetrics().mergeInto(total);
+}
+
+unsigned long   IRCServer::getUptime() const
+{
+    return (std::time(NULL) - _startTime);
+}
+
+/*
+** initialize()
+** Installs signal handlers, then creates the event loops (and, for
+** more than one, the ShardGroup connecting them); each loop opens its
+** listening socket.
+*/
+void    IRCServer::initialize()
+{
+    _instance = this;
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+    signal(SIGHUP, signalHandler);
+#ifdef IRCSERV_TRACE
+    signal(SIGUSR2, signalHandler);
+#endif
+    signal(SIGPIPE, SIG_IGN);
+
+    if (_reactorCount > 1)
+        _shards = new ShardGroup(_reactorCount);
+    for (unsigned int i = 0; i < _reactorCount; i++)
+    {
+        _reactors.push_back(new Reactor(*this, i));
+        _reactors[i]->initialize(_port, _shards, _backend);
+    }
+    __atomic_store_n(&_running, true, __ATOMIC_RELAXED);
+}
+
+/*
+** run()
+** Runs reactor 0 on the calling thread and the others on their own.
+** Shard threads block the handled signals, so signals always land on
+** the main thread; the handler wakes every loop through its eventfd.
+** Returns once every loop has stopped.
+*/
+void    IRCServer::run()
+{
+    sigset_t    handled;
+    sigset_t    previous;
+
+    sigemptyset(&handled);
+    sigaddset(&handled, SIGINT);
+    sigaddset(&handled, SIGTERM);
+    sigaddset(&handled, SIGHUP);
+    sigaddset(&handled, SIGUSR2);
+    pthread_sigmask(SIG_BLOCK, &handled, &previous);
+
+    size_t started = 1;
+    try
+    {
+        for (; started < _reactors.size(); started++)
+            _reactors[started]->start();
+        if (_metricsEndpoint != NULL)
+            _metricsEndpoint->start();
+    }
+    catch (...)
+    {
+        pthread_sigmask(SIG_SETMASK, &previous, NULL);
+        shutdown();
+        for (size_t i = 1; i < started; i++)
+            _reactors[i]->join();
+        throw ;
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    try
+    {
+        _reactors[0]->run();
+    }
+    catch (...)
+    {
+        shutdown();
+        for (size_t i = 1; i < _reactors.size(); i++)
+            _reactors[i]->join();
+        if (_metricsEndpoint != NULL)
+            _metricsEndpoint->stop();
+        throw ;
+    }
+    shutdown();
+    for (size_t i = 1; i < _reactors.size(); i++)
+        _reactors[i]->join();
+    if (_metricsEndpoint != NULL)
+        _metricsEndpoint->stop();
+}
+
+void    IRCServer::shutdown()
+{
+    __atomic_store_n(&_running, false, __ATOMIC_RELAXED);
+    wakeReactors();
+}
+
+/*
+** wakeReactors() [PRIVATE]
+** Interrupts every shard's event wait (async-signal-safe: one write()
+** per eventfd). Nothing to do with a single loop.
+*/
+void    IRCServer::wakeReactors()
+{
+    if (_shards == NULL)
+        return ;
+    for (unsigned int i = 0; i < _shards->size(); i++)
+        _shards->wake(i);
+}
+
+/*
+** signalHandler(int sig)
+** SIGHUP asks for a MOTD reload, SIGUSR2 (traced builds only) for a
+** trace dump, anything else stops the server. Only
+** flags are set here (and the loops woken), the loops do the work.
+** The flags are lock-free atomics, safe in a handler and across loops.
+*/
+void    IRCServer::signalHandler(int sig)
+{
+    int savedErrno = errno;
+
+    if (_instance == NULL)
+        return ;
+    if (sig == SIGHUP)
+        __atomic_add_fetch(&_instance->_motdGeneration, 1, __ATOMIC_RELAXED);
+    else if (sig == SIGUSR2)
+        __atomic_add_fetch(&_instance->_traceGeneration, 1, __ATOMIC_RELAXED);
+    else
+        __atomic_store_n(&_instance->_running, false, __ATOMIC_RELAXED);
+    _instance->wakeReactors();
+    errno = savedErrno;
+}
+
+bool    IRCServer::isRunning() const
+{
+    return (__atomic_load_n(&_running, __ATOMIC_RELAXED));
+}
+
+unsigned int    IRCServer::getMotdGeneration() const
+{
+    return (__atomic_load_n(&_motdGeneration, __ATOMIC_RELAXED));
+}
+
+unsigned int    IRCServer::getTraceGeneration() const
+{
+    return (__atomic_load_n(&_traceGeneration, __ATOMIC_RELAXED));
+}
+
+const std::string&  IRCServer::getPassword() const
+{
+    return (_password);
+}
+
+UserRegistry&   IRCServer::getUserRegistry()
+{
+    return (_userRegistry);
+}
+
+ChannelRegistry&    IRCServer::getChannelRegistry()
+{
+    return (_channelRegistry);
+}
+
+/*
+** lockState() / unlockState()
+** Guards the shared IRC state (registries, clients, channels, atoms)
+** while a loop handles its cycle. A no-op with a single loop.
+*/
+void    IRCServer::lockState()
+{
+    if (_shards != NULL)
+        pthread_mutex_lock(&_stateLock);
+}
+
+void    IRCServer::unlockState()
+{
+    if (_shards != NULL)
+        pthread_mutex_unlock(&_stateLock);
+}
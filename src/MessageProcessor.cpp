@@ -11,10 +11,70 @@
 /* ************************************************************************** */
 
 #include "../inc/MessageProcessor.hpp"
+#include <cstring>
+#include <algorithm>
+
+IRCMessage::IRCMessage() {}
+
+StringSlice::StringSlice() : data(""), length(0) {}
+
+StringSlice::StringSlice(const char* data, size_t length) : data(data), length(length) {}
+
+bool    StringSlice::empty() const
+{
+    return (length == 0);
+}
+
+bool    StringSlice::equals(const char* literal) const
+{
+    return (std::strlen(literal) == length && std::memcmp(data, literal, length) == 0);
+}
+
+std::string StringSlice::str() const
+{
+    return (std::string(data, length));
+}
+
+IRCMessageView::IRCMessageView() : paramCount(0), hasTrailing(false) {}
+
+/*
+** IRCMessageView(const IRCMessage& message)
+** View of an owning message (valid while message is); params past
+** MAX_PARAMS are dropped, as the parser would.
+*/
+IRCMessageView::IRCMessageView(const IRCMessage& message)
+    : prefix(message.prefix.data(), message.prefix.length()),
+    command(message.command.data(), message.command.length()),
+    paramCount(std::min(message.params.size(), (size_t)MAX_PARAMS)),
+    trailing(message.trailing.data(), message.trailing.length()),
+    hasTrailing(!message.trailing.empty())
+{
+    for (size_t i = 0; i < paramCount; i++)
+        params[i] = StringSlice(message.params[i].data(), message.params[i].length());
+}
+
+/*
+** toMessage()
+** Owning copy of the view, for code that keeps a message past the
+** lifetime of the receive buffer.
+*/
+IRCMessage  IRCMessageView::toMessage() const
+{
+    IRCMessage msg;
+    
+    msg.prefix = prefix.str();
+    msg.command = command.str();
+    msg.params.reserve(paramCount);
+    for (size_t i = 0; i < paramCount; i++)
+        msg.params.push_back(params[i].str());
+    msg.trailing = trailing.str();
+    return (msg);
+}
 
 /*
 ** parse(const std::string& rawMessage)
 ** Parses raw IRC message string into structured IRCMessage object.
+** Owning wrapper around parseView().
 **
 ** Format: [:prefix] <command> [params] [:trailing]\r\n
 **
@@ -23,59 +83,116 @@
 */
 IRCMessage MessageProcessor::parse(const std::string& rawMessage)
 {
-    IRCMessage msg;
-    std::string input = rawMessage;
+    IRCMessageView view;
     
-    if (rawMessage.empty() || rawMessage.size() < 2)
-        return (msg);
+    if (!parseView(rawMessage.data(), rawMessage.length(), view))
+        return (IRCMessage());
+    return (view.toMessage());
+}
+
+/*
+** parseView(const char* data, size_t length, IRCMessageView& view)
+** Allocation-free parser: splits one line into slices of data.
+**
+** Format: [:prefix] <command> [params] [:trailing]\r\n
+**
+** - A trailing \r\n (or lone \n) is ignored
+** - Runs of spaces separate fields (RFC 1459 <SPACE>)
+** - After 14 middle params the rest of the line is the trailing
+**   parameter even without ':' (RFC 2812), so params never overflow
+**
+** Returns: true if a command was found (view filled),
+**          false for an empty or prefix-only line
+*/
+bool    MessageProcessor::parseView(const char* data, size_t length, IRCMessageView& view)
+{
+    view.paramCount = 0;
+    view.hasTrailing = false;
+    view.prefix = StringSlice();
+    view.command = StringSlice();
+    view.trailing = StringSlice();
+
+    if (length > 0 && data[length - 1] == '\n')
+        length--;
+    if (length > 0 && data[length - 1] == '\r')
+        length--;
+
+    const char* pos = data;
+    const char* end = data + length;
     
-    if (input.size() >= 2 && input.substr(input.size() - 2) == "\r\n")
-        input = input.substr(0, input.size() - 2);
-
-    if (input.empty())
-        return (msg);
-        
-    size_t pos = 0;
-    if (!input.empty() && input[0] == ':')
-    {
-        size_t space = input.find(' ');
-        if (space != std::string::npos)
-        {
-            msg.prefix = input.substr(1, space - 1);
-            pos = space + 1;
-        }
-    }
-    size_t space = input.find(' ', pos);
-    if (space != std::string::npos)
-    {
-        msg.command = input.substr(pos, space - pos);
-        pos = space + 1;
-    }
-    else
+    if (pos < end && *pos == ':')
     {
-        msg.command = input.substr(pos);
-        return (msg);
+        const char* space = static_cast<const char*>(std::memchr(pos, ' ', end - pos));
+        if (space == NULL)
+            return (false);
+        view.prefix = StringSlice(pos + 1, space - pos - 1);
+        pos = space;
     }
-    while (pos < input.length())
+    while (pos < end && *pos == ' ')
+        pos++;
+    
+    const char* space = static_cast<const char*>(std::memchr(pos, ' ', end - pos));
+    if (space == NULL)
+        space = end;
+    view.command = StringSlice(pos, space - pos);
+    pos = space;
+    if (view.command.empty())
+        return (false);
+
+    while (pos < end)
     {
-        if (input[pos] == ':')
-        {
-            msg.trailing = input.substr(pos + 1);
+        while (pos < end && *pos == ' ')
+            pos++;
+        if (pos == end)
             break ;
-        }
-        space = input.find(' ', pos);
-        if (space != std::string::npos)
+        if (*pos == ':' || view.paramCount == MAX_PARAMS - 1)
         {
-            msg.params.push_back(input.substr(pos, space - pos));
-            pos = space + 1;
+            if (*pos == ':')
+                pos++;
+            view.trailing = StringSlice(pos, end - pos);
+            view.hasTrailing = true;
+            break ;
         }
-        else
+        space = static_cast<const char*>(std::memchr(pos, ' ', end - pos));
+        if (space == NULL)
+            space = end;
+        view.params[view.paramCount++] = StringSlice(pos, space - pos);
+        pos = space;
+    }
+    return (true);
+}
+
+/*
+** Every 3-digit code rendered once at startup, so replies copy 3 bytes
+** instead of running a stringstream.
+*/
+struct NumericTable
+{
+    char    codes[1000][4];
+
+    NumericTable()
+    {
+        for (int i = 0; i < 1000; i++)
         {
-            msg.params.push_back(input.substr(pos));
-            break ;
+            codes[i][0] = '0' + i / 100;
+            codes[i][1] = '0' + i / 10 % 10;
+            codes[i][2] = '0' + i % 10;
+            codes[i][3] = '\0';
         }
     }
-    return (msg);
+};
+
+static const NumericTable   g_numerics;
+
+/*
+** numericCode(int code)
+** Returns: zero-padded 3-character code ("001"), "000" if out of range
+*/
+const char* MessageProcessor::numericCode(int code)
+{
+    if (code < 0 || code > 999)
+        code = 0;
+    return (g_numerics.codes[code]);
 }
 
 /*
@@ -89,25 +206,21 @@ IRCMessage MessageProcessor::parse(const std::string& rawMessage)
 **   target  - Client nickname
 **   message - Reply message
 **
-** Returns: Formatted IRC numeric reply string
+** Returns: Formatted IRC numeric reply string (one allocation; the hot
+**          path writes replies in place with ReplyBuilder instead)
 */
 std::string MessageProcessor::buildNumericReply(int code, const std::string& target, const std::string& message)
 {
-    std::string result; 
-    result = ":ircserv ";
-
-    std::stringstream ss; 
-    ss << std::setfill('0') << std::setw(3) << code;
-    result += ss.str();
-    result += " ";
+    std::string result;
+    result.reserve(SERVER_PREFIX_LENGTH + 4 + target.length() + 2 + message.length() + 2);
 
+    result.append(SERVER_PREFIX, SERVER_PREFIX_LENGTH);
+    result.append(numericCode(code), 3);
+    result += ' ';
     result += target;
-    result += " ";
-
-    result += ":";
+    result.append(" :", 2);
     result += message;
-
-    result += "\r\n";
+    result.append("\r\n", 2);
     return (result);
 }
 
@@ -124,27 +237,32 @@ std::string MessageProcessor::buildNumericReply(int code, const std::string& tar
 */
 std::string MessageProcessor::buildMessage(const IRCMessage& message)
 {
-    std::string result; 
+    size_t  size = message.prefix.length() + message.command.length() + message.trailing.length() + 6;
+    for (size_t i = 0; i < message.params.size(); i++)
+        size += message.params[i].length() + 1;
+
+    std::string result;
+    result.reserve(size);
     if (!message.prefix.empty())
     {
-        result = ":";
+        result += ':';
         result += message.prefix;
-        result += " ";
+        result += ' ';
     }
 
     result += message.command;
 
     for (size_t i = 0; i < message.params.size(); i++)
     {
-        result += " ";
+        result += ' ';
         result += message.params[i];
     }
 
     if (!message.trailing.empty())
     {
-        result += ":";
+        result.append(" :", 2);
         result += message.trailing;
     }
-    result += "\r\n";
+    result.append("\r\n", 2);
     return (result);
-}
\ No newline at end of file
+}
@@ -0,0 +1,215 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Metrics.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:20:51 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 18:20:51 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/Metrics.hpp"
+#include "../inc/CommandEngine.hpp"
+#include <sstream>
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram() : _count(0), _sum(0), _max(0)
+{
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+        _buckets[i] = 0;
+}
+
+/*
+** bucketOf(unsigned long value) [PRIVATE, STATIC]
+** Values below HISTOGRAM_SUB_BUCKETS map to themselves. Above, the
+** position of the top bit picks the power of two, the next
+** HISTOGRAM_SUB_BITS bits the linear bucket inside it.
+*/
+size_t  LatencyHistogram::bucketOf(unsigned long value)
+{
+    if (value < HISTOGRAM_SUB_BUCKETS)
+        return (value);
+
+    size_t exponent = sizeof(unsigned long) * 8 - 1 - __builtin_clzl(value);
+    if (exponent > HISTOGRAM_MAX_EXPONENT)
+        return (HISTOGRAM_BUCKETS - 1);
+    size_t sub = (value >> (exponent - HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB_BUCKETS - 1);
+    return (HISTOGRAM_SUB_BUCKETS * (exponent - HISTOGRAM_SUB_BITS + 1) + sub);
+}
+
+/*
+** upperBound(size_t bucket) [PRIVATE, STATIC]
+** Returns: the largest value that lands in bucket
+*/
+unsigned long   LatencyHistogram::upperBound(size_t bucket)
+{
+    if (bucket < HISTOGRAM_SUB_BUCKETS)
+        return (bucket);
+
+    size_t exponent = bucket / HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BITS - 1;
+    size_t sub = bucket % HISTOGRAM_SUB_BUCKETS;
+    unsigned long width = 1UL << (exponent - HISTOGRAM_SUB_BITS);
+    return (((HISTOGRAM_SUB_BUCKETS + sub) << (exponent - HISTOGRAM_SUB_BITS)) + width - 1);
+}
+
+void    LatencyHistogram::record(unsigned long ns)
+{
+    counterAdd(_buckets[bucketOf(ns)], 1);
+    counterAdd(_count, 1);
+    counterAdd(_sum, ns);
+    if (ns > _max)
+        counterSet(_max, ns);
+}
+
+/*
+** mergeInto(LatencyHistogram& total) const
+** Adds this histogram to total, a private snapshot (plain writes), while
+** the owning loop may still be recording.
+*/
+void    LatencyHistogram::mergeInto(LatencyHistogram& total) const
+{
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+        total._buckets[i] += counterGet(_buckets[i]);
+    total._count += counterGet(_count);
+    total._sum += counterGet(_sum);
+    total._max = std::max(total._max, counterGet(_max));
+}
+
+unsigned long   LatencyHistogram::getCount() const
+{
+    return (counterGet(_count));
+}
+
+unsigned long   LatencyHistogram::getSum() const
+{
+    return (counterGet(_sum));
+}
+
+unsigned long   LatencyHistogram::getMax() const
+{
+    return (counterGet(_max));
+}
+
+/*
+** quantile(double q) const
+** Walks the buckets up to the q-th recorded value (0 < q <= 1).
+**
+** Returns: upper bound of its bucket (capped by the maximum seen),
+**          0 if nothing was recorded
+*/
+unsigned long   LatencyHistogram::quantile(double q) const
+{
+    unsigned long count = 0;
+
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+        count += counterGet(_buckets[i]);
+    if (count == 0)
+        return (0);
+
+    unsigned long rank = (unsigned long)(q * count + 0.5);
+    if (rank == 0)
+        rank = 1;
+    unsigned long seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        seen += counterGet(_buckets[i]);
+        if (seen >= rank)
+            return (std::min(upperBound(i), getMax()));
+    }
+    return (getMax());
+}
+
+Metrics::Metrics()
+    : loopIterations(0), bytesIn(0), bytesOut(0), linesIn(0), parseErrors(0),
+    connectionsAccepted(0), connectionsClosed(0), connections(0), sendQBytes(0)
+{
+    for (size_t i = 0; i <= CMD_COUNT; i++)
+        commands[i] = 0;
+}
+
+/*
+** mergeInto(Metrics& total) const
+** Adds this loop's metrics to total (see LatencyHistogram::mergeInto()).
+*/
+void    Metrics::mergeInto(Metrics& total) const
+{
+    total.loopIterations += counterGet(loopIterations);
+    total.bytesIn += counterGet(bytesIn);
+    total.bytesOut += counterGet(bytesOut);
+    total.linesIn += counterGet(linesIn);
+    total.parseErrors += counterGet(parseErrors);
+    total.connectionsAccepted += counterGet(connectionsAccepted);
+    total.connectionsClosed += counterGet(connectionsClosed);
+    total.connections += counterGet(connections);
+    total.sendQBytes += counterGet(sendQBytes);
+    for (size_t i = 0; i <= CMD_COUNT; i++)
+    {
+        total.commands[i] += counterGet(commands[i]);
+        commandTime[i].mergeInto(total.commandTime[i]);
+    }
+    loopTime.mergeInto(total.loopTime);
+    sendDelay.mergeInto(total.sendDelay);
+}
+
+static void renderSummary(std::ostringstream& out, const std::string& name,
+    const std::string& labels, const LatencyHistogram& histogram)
+{
+    static const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    std::string         separator = labels.empty() ? "" : ",";
+
+    for (size_t i = 0; i < sizeof(quantiles) / sizeof(quantiles[0]); i++)
+        out << name << "{" << labels << separator << "quantile=\"" << quantiles[i] << "\"} "
+            << histogram.quantile(quantiles[i]) << "\n";
+    out << name << "_max" << (labels.empty() ? "" : "{" + labels + "}") << " "
+        << histogram.getMax() << "\n";
+    out << name << "_sum" << (labels.empty() ? "" : "{" + labels + "}") << " "
+        << histogram.getSum() << "\n";
+    out << name << "_count" << (labels.empty() ? "" : "{" + labels + "}") << " "
+        << histogram.getCount() << "\n";
+}
+
+/*
+** render(unsigned long uptime) const
+** Plain-text exposition (Prometheus format) of a snapshot: counters and
+** gauges, then each latency histogram as a summary (ns quantiles, max,
+** sum and count). Commands never seen are left out.
+*/
+std::string Metrics::render(unsigned long uptime) const
+{
+    std::ostringstream  out;
+
+    out << "# TYPE ircserv_uptime_seconds gauge\nircserv_uptime_seconds " << uptime << "\n"
+        << "# TYPE ircserv_loop_iterations_total counter\n"
+        << "ircserv_loop_iterations_total " << loopIterations << "\n"
+        << "# TYPE ircserv_bytes_in_total counter\nircserv_bytes_in_total " << bytesIn << "\n"
+        << "# TYPE ircserv_bytes_out_total counter\nircserv_bytes_out_total " << bytesOut << "\n"
+        << "# TYPE ircserv_lines_in_total counter\nircserv_lines_in_total " << linesIn << "\n"
+        << "# TYPE ircserv_parse_errors_total counter\n"
+        << "ircserv_parse_errors_total " << parseErrors << "\n"
+        << "# TYPE ircserv_connections_accepted_total counter\n"
+        << "ircserv_connections_accepted_total " << connectionsAccepted << "\n"
+        << "# TYPE ircserv_connections_closed_total counter\n"
+        << "ircserv_connections_closed_total " << connectionsClosed << "\n"
+        << "# TYPE ircserv_connections gauge\nircserv_connections " << connections << "\n"
+        << "# TYPE ircserv_sendq_bytes gauge\nircserv_sendq_bytes " << sendQBytes << "\n";
+
+    out << "# TYPE ircserv_commands_total counter\n";
+    for (size_t i = 0; i <= CMD_COUNT; i++)
+        if (commands[i] != 0)
+            out << "ircserv_commands_total{command=\"" << CommandEngine::name((CommandId)i)
+                << "\"} " << commands[i] << "\n";
+
+    out << "# TYPE ircserv_loop_duration_ns summary\n";
+    renderSummary(out, "ircserv_loop_duration_ns", "", loopTime);
+    out << "# TYPE ircserv_command_duration_ns summary\n";
+    for (size_t i = 0; i <= CMD_COUNT; i++)
+        if (commandTime[i].getCount() != 0)
+            renderSummary(out, "ircserv_command_duration_ns",
+                std::string("command=\"") + CommandEngine::name((CommandId)i) + "\"",
+                commandTime[i]);
+    out << "# TYPE ircserv_send_delay_ns summary\n";
+    renderSummary(out, "ircserv_send_delay_ns", "", sendDelay);
+    return (out.str());
+}
@@ -0,0 +1,183 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MetricsEndpoint.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:05:32 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 20:05:32 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/MetricsEndpoint.hpp"
+#include "../inc/IRCServer.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+MetricsEndpoint::MetricsEndpoint(IRCServer& server, const std::string& path)
+    : _server(server), _path(path), _socket(-1), _running(false)
+{
+    _wakePipe[0] = -1;
+    _wakePipe[1] = -1;
+}
+
+MetricsEndpoint::~MetricsEndpoint()
+{
+    stop();
+}
+
+/*
+** start()
+** Binds the socket (a stale socket file left by a previous run is
+** replaced, any other file is not) and starts the serving thread.
+**
+** Throws: std::runtime_error if the path is unusable or the thread
+**         cannot be created
+*/
+void    MetricsEndpoint::start()
+{
+    struct sockaddr_un  address;
+    struct stat         info;
+
+    if (_path.empty() || _path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("Error: metrics socket path is empty or too long");
+    if (lstat(_path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+        unlink(_path.c_str());
+
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, _path.c_str(), _path.size());
+    _socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_socket == -1 || pipe(_wakePipe) == -1)
+    {
+        closeAll();
+        throw std::runtime_error("Error: metrics socket creation failed");
+    }
+    fcntl(_socket, F_SETFD, FD_CLOEXEC);
+    fcntl(_wakePipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(_wakePipe[1], F_SETFD, FD_CLOEXEC);
+    if (bind(_socket, (struct sockaddr*)&address, sizeof(address)) == -1
+        || listen(_socket, 16) == -1)
+    {
+        closeAll();
+        throw std::runtime_error("Error: metrics socket bind failed: " + _path);
+    }
+    if (pthread_create(&_thread, NULL, threadMain, this) != 0)
+    {
+        closeAll();
+        unlink(_path.c_str());
+        throw std::runtime_error("Error: metrics thread creation failed");
+    }
+    _running = true;
+}
+
+/*
+** stop()
+** Wakes the thread, waits for it, removes the socket file.
+*/
+void    MetricsEndpoint::stop()
+{
+    if (!_running)
+        return ;
+    _running = false;
+    char wake = 0;
+    while (write(_wakePipe[1], &wake, 1) == -1 && errno == EINTR)
+        ;
+    pthread_join(_thread, NULL);
+    closeAll();
+    unlink(_path.c_str());
+}
+
+void    MetricsEndpoint::closeAll()
+{
+    if (_socket != -1)
+        close(_socket);
+    if (_wakePipe[0] != -1)
+        close(_wakePipe[0]);
+    if (_wakePipe[1] != -1)
+        close(_wakePipe[1]);
+    _socket = -1;
+    _wakePipe[0] = -1;
+    _wakePipe[1] = -1;
+}
+
+void*   MetricsEndpoint::threadMain(void* endpoint)
+{
+    static_cast<MetricsEndpoint*>(endpoint)->serve();
+    return (NULL);
+}
+
+/*
+** serve() [PRIVATE]
+** Accept loop until the wake pipe becomes readable. Scrapes are served
+** one at a time.
+*/
+void    MetricsEndpoint::serve()
+{
+    struct pollfd   fds[2];
+
+    fds[0].fd = _socket;
+    fds[0].events = POLLIN;
+    fds[1].fd = _wakePipe[0];
+    fds[1].events = POLLIN;
+    while (true)
+    {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (poll(fds, 2, -1) == -1 && errno != EINTR)
+            return ;
+        if (fds[1].revents != 0)
+            return ;
+        if (fds[0].revents == 0)
+            continue ;
+        int client = accept(_socket, NULL, NULL);
+        if (client == -1)
+            continue ;
+        try
+        {
+            respond(client);
+        }
+        catch (std::exception& e)
+        {
+            // out of memory for the snapshot: this scrape gets nothing
+        }
+        close(client);
+    }
+}
+
+/*
+** respond(int fd) [PRIVATE]
+** Writes one snapshot, blocking, for METRICS_SEND_TIMEOUT_S at most.
+*/
+void    MetricsEndpoint::respond(int fd)
+{
+    struct timeval  timeout;
+
+    timeout.tv_sec = METRICS_SEND_TIMEOUT_S;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    Metrics* metrics = new Metrics();
+    _server.collectMetrics(*metrics);
+    std::string text = metrics->render(_server.getUptime());
+    delete metrics;
+
+    size_t done = 0;
+    while (done < text.size())
+    {
+        ssize_t count = send(fd, text.data() + done, text.size() - done, MSG_NOSIGNAL);
+        if (count == -1 && errno == EINTR)
+            continue ;
+        if (count <= 0)
+            return ;
+        done += count;
+    }
+}
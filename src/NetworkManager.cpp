@@ -12,18 +12,28 @@
 
 #include "../inc/NetworkManager.hpp"
 
-NetworkManager::NetworkManager() : _serverSocket(-1) {}
+NetworkManager::NetworkManager()
+    : _serverSocket(-1), _backend(NULL), _sendQLimit(DEFAULT_SENDQ_LIMIT), _sendQPolicy(NULL),
+    _floodBurst(FLOOD_BURST), _floodRefillMs(FLOOD_REFILL_MS), _now(monotonicMs()),
+    _cycleStart(0), _timers(_now), _shards(NULL), _shardId(0), _completion(false),
+    _acceptPending(false), _acceptRetryAt(0) {}
 
 NetworkManager::~NetworkManager()
 {
-    for (size_t i = 1; i < _pollFds.size(); i++)
-        close(_pollFds[i].fd);
+    for (size_t i = 0; i < _connections.size(); i++)
+    {
+        if (_shards != NULL)
+            _shards->setOwner(_connections.at(i).fd, -1);
+        close(_connections.at(i).fd);
+    }
+    closeDeferred();
     if (_serverSocket != -1)
         close(_serverSocket);
+    delete _backend;
 }
 
 /*
-** initialize(int port)
+** initialize(int port, EventBackendType backend)
 ** Sets up server socket and begins listening for connections.
 ** 
 ** Steps:
@@ -32,12 +42,18 @@ NetworkManager::~NetworkManager()
 ** 3. Sets non-blocking mode
 ** 4. Binds to specified port on all interfaces (INADDR_ANY)
 ** 5. Starts listening with maximum queue (SOMAXCONN)
-** 6. Adds server socket to poll array for monitoring
+** 6. Creates the event backend (epoll by default on Linux, poll
+**    otherwise, io_uring on request) and registers the server socket
+**    with it
+**
+** In a shard group (attachShardGroup() first), every shard binds its
+** own listener with SO_REUSEPORT, so the kernel spreads connections
+** over them, and also watches its wakeup eventfd.
 **
 ** Throws: std::runtime_error on socket/bind/listen failure
 ** Note: Port must be between 1-65535 (validated by IRCServer)
 */
-void    NetworkManager::initialize(int port)
+void    NetworkManager::initialize(int port, EventBackendType backend)
 {
     _serverSocket = socket(AF_INET, SOCK_STREAM, 0);
     if (_serverSocket == -1)
@@ -45,6 +61,10 @@ void    NetworkManager::initialize(int port)
         
     int opt = 1;
     setsockopt(_serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+#ifdef SO_REUSEPORT
+    if (_shards != NULL)
+        setsockopt(_serverSocket, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt));
+#endif
     fcntl(_serverSocket, F_SETFL, O_NONBLOCK);
     
     struct sockaddr_in  serverAddress;
@@ -64,12 +84,45 @@ void    NetworkManager::initialize(int port)
         throw std::runtime_error("Error: listen failed");
     }
     
-    struct pollfd serverPollFd;
-    serverPollFd.fd = _serverSocket;
-    serverPollFd.events = POLLIN;
-    serverPollFd.revents = 0;
+    createBackend(backend);
+    _backend->addListener(_serverSocket);
+}
+
+/*
+** initializeDetached(EventBackendType backend)
+** Same as initialize() without a listening socket: the connections are
+** handed over with adoptSocket(). Used to drive the server in-process
+** (socketpair() transports, see bench/pipebench.cpp), with no port to
+** allocate and no TCP stack in the way.
+*/
+void    NetworkManager::initializeDetached(EventBackendType backend)
+{
+    createBackend(backend);
+}
+
+/*
+** createBackend(EventBackendType backend) [PRIVATE]
+** Creates the event backend, and watches the shard wakeup eventfd in a
+** shard group.
+*/
+void    NetworkManager::createBackend(EventBackendType backend)
+{
+    _backend = IEventBackend::create(backend);
+    _completion = _backend->completesIO();
+    if (_shards != NULL)
+        _backend->addFd(_shards->getWakeFd(_shardId));
+}
 
-    _pollFds.push_back(serverPollFd);
+/*
+** attachShardGroup(ShardGroup* group, unsigned int shard)
+** Makes this manager shard number shard of group (multi-reactor mode).
+** Sends to fds it does not own are then forwarded to their owner.
+** Must be called before initialize().
+*/
+void    NetworkManager::attachShardGroup(ShardGroup* group, unsigned int shard)
+{
+    _shards = group;
+    _shardId = shard;
 }
 
 /*
@@ -77,12 +130,26 @@ void    NetworkManager::initialize(int port)
 ** Main event detection loop - waits for and processes network events.
 ** 
 ** Process:
-** 1. Clears previous event tracking
-** 2. Calls poll() - BLOCKS until activity on any file descriptor
-** 3. Iterates through all file descriptors with events
-**    - Index 0 (server socket): New connection → handleNewConnection()
-**    - Index 1+ (clients): Data/disconnect → handleClientEvent()
-** 4. Cleans up disconnected clients
+** 1. Clears previous event tracking (the sockets adopted since the
+**    last cycle become its new connections), closes the fds reported as
+**    disconnected last cycle (and, in a shard group, posts the output
+**    staged for other shards); a completion backend gets this cycle's
+**    sends, submitted together with the wait
+** 2. Backend wait() - BLOCKS until activity on any file descriptor,
+**    or returns at once when a connection still has unread data or
+**    is waiting to be closed, or when a throttled client earns its
+**    next flood token or the next timer is due
+** 3. Turns the timer wheel, the owners of expired timers are reported
+**    by getExpiredTimers()
+** 4. Iterates only over the fds the backend reported as ready
+**    - Accepted by a completion backend → acceptCompleted()
+**    - Clients: Data/disconnect → handleClientEvent()
+**    then accepts new connections if the server socket was ready
+**    (handleNewConnection())
+** 5. Resumes reads that stopped on a full receive ring last cycle
+** 6. Every drop noticed since the last cleanup (here, in sendMessage()
+**    or via removeClient()) becomes this cycle's disconnect list
+** 7. Cleans up disconnected clients
 **
 ** Called repeatedly in main server loop.
 ** Handles multiple simultaneous events in single call.
@@ -90,157 +157,554 @@ void    NetworkManager::initialize(int port)
 void    NetworkManager::pollEvents()
 {
     _newConnections.clear();
+    _newConnections.swap(_adoptedConnections);
     _disconnectedClients.clear();
+    _expiredTimers.clear();
+    closeDeferred();
+    if (_shards != NULL)
+        _shards->flush(_shardId);
+    if (_completion)
+        submitSends();
     
-    int ready = poll(&_pollFds[0], _pollFds.size(), -1);
+    int ready = _backend->wait(_events, computeTimeout());
+    _cycleStart = Metrics::clock();
+    _now = _cycleStart / 1000000UL;
+    counterAdd(_metrics.loopIterations, 1);
+    _timers.advance(_now, _expiredTimers);
     
     if (ready == -1)
     {
-        if (errno == EINTR)
-            return ;
-        throw std::runtime_error("Error: poll failed");
+        if (errno != EINTR)
+            throw std::runtime_error("Error: event wait failed");
+        _events.clear();
     }
     
-    for (size_t i = 0; i < _pollFds.size(); i++)
+    bool acceptReady = _acceptPending || (_acceptRetryAt != 0 && _now >= _acceptRetryAt);
+    for (size_t i = 0; i < _events.size(); i++)
     {
-        if (_pollFds[i].revents == 0)
-            continue ;
-        if (i == 0)
-            handleNewConnection();
+        if (_events[i].flags & EVENT_ACCEPT)
+            acceptCompleted(_events[i].fd);
+        else if (_events[i].fd == _serverSocket)
+            acceptReady = true;
+        else if (_shards != NULL && _events[i].fd == _shards->getWakeFd(_shardId))
+            receiveForwarded();
         else
-            handleClientEvent(i);
+            handleClientEvent(_events[i]);
     }
+    if (acceptReady)
+        handleNewConnection();
+    resumePendingReads();
+    _disconnectedClients.swap(_pendingRemovals);
     cleanupDisconnectedClients();
 }
 
 /*
 ** handleNewConnection() [PRIVATE]
-** Accepts new client connection and adds to monitoring.
+** Accepts pending client connections and adds them to monitoring.
 **
-** Steps:
-** 1. accept() - creates new client socket
-** 2. Sets client socket to non-blocking mode
-** 3. Adds to _pollFds for future monitoring (POLLIN events)
-** 4. Tracks in _newConnections for IRCServer processing
+** accept4() returns the socket already non-blocking and close-on-exec
+** with the peer address, one syscall per connection. The loop runs
+** until EAGAIN (required by the edge-triggered backend, which only
+** signals the listener once), but at most ACCEPT_BATCH times per cycle
+** so a reconnect storm does not starve the clients already connected:
+** the rest of the backlog is taken next cycle (_acceptPending makes
+** that cycle's wait return at once).
+** Out of descriptors or memory (EMFILE, ENFILE, ENOBUFS, ENOMEM), the
+** backlog is left queued and retried ACCEPT_RETRY_MS later: the edge
+** has been consumed, so nothing would report those connections again
+** until another client connects, and retrying at once would spin.
 **
 ** Errors handled gracefully - bad connections don't crash server.
 */
 void    NetworkManager::handleNewConnection()
 {
-    int clientFd = accept(_serverSocket, NULL, NULL);
-    if (clientFd == -1)
-        return ;
-    
-    if (fcntl(clientFd, F_SETFL, O_NONBLOCK) == -1)
+    _acceptPending = false;
+    _acceptRetryAt = 0;
+    for (size_t accepted = 0; accepted < ACCEPT_BATCH; )
+    {
+        struct sockaddr_in  peer;
+        socklen_t           length = sizeof(peer);
+        int clientFd = accept4(_serverSocket, (struct sockaddr*)&peer, &length,
+                SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientFd == -1)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue ;
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+                _acceptRetryAt = _now + ACCEPT_RETRY_MS;
+            return ;
+        }
+        admitConnection(clientFd, peer.sin_addr.s_addr);
+        accepted++;
+    }
+    _acceptPending = true;
+}
+
+/*
+** acceptCompleted(int clientFd) [PRIVATE]
+** A completion backend accepted clientFd (multishot accept, already
+** non-blocking); its peer address is read back with getpeername().
+*/
+void    NetworkManager::acceptCompleted(int clientFd)
+{
+    struct sockaddr_in  peer;
+    socklen_t           length = sizeof(peer);
+
+    if (getpeername(clientFd, (struct sockaddr*)&peer, &length) == -1)
     {
         close(clientFd);
         return ;
     }
+    admitConnection(clientFd, peer.sin_addr.s_addr);
+}
 
-    struct pollfd clientPollFd;
-    clientPollFd.fd = clientFd;
-    clientPollFd.events = POLLIN;
-    clientPollFd.revents = 0;
-    
-    _pollFds.push_back(clientPollFd);
-    _newConnections.push_back(clientFd);
-}  
+/*
+** admitConnection(int clientFd, uint32_t peerAddr) [PRIVATE]
+** Per-address limits (HostLimiter) before anything is allocated for
+** the connection: too many connections open from the host, or too
+** many attempts in a short time → refused. In a shard group the
+** group's limiter counts the host's connections on every shard.
+*/
+void    NetworkManager::admitConnection(int clientFd, uint32_t peerAddr)
+{
+    HostVerdict verdict = (_shards != NULL) ? _shards->admitHost(peerAddr, _now)
+        : _hostLimits.admit(peerAddr, _now);
+
+    if (verdict == HOST_TOO_MANY)
+        refuseConnection(clientFd, peerAddr, "Too many connections from your host");
+    else if (verdict == HOST_TOO_FAST)
+        refuseConnection(clientFd, peerAddr, "Connecting too fast");
+    else
+    {
+        adoptConnection(clientFd, peerAddr);
+        _newConnections.push_back(clientFd);
+    }
+}
 
 /*
-** handleClientEvent(size_t index) [PRIVATE]
+** refuseConnection(int clientFd, uint32_t peerAddr, const char* reason) [PRIVATE]
+** Best-effort ERROR line (one non-blocking send, never queued), then
+** close. The IRC layer never hears of the connection.
+*/
+void    NetworkManager::refuseConnection(int clientFd, uint32_t peerAddr, const char* reason)
+{
+    char            host[INET_ADDRSTRLEN];
+    struct in_addr  addr;
+
+    addr.s_addr = peerAddr;
+    if (inet_ntop(AF_INET, &addr, host, sizeof(host)) == NULL)
+        host[0] = '\0';
+    std::string line = std::string("ERROR :Closing Link: ") + host + " (" + reason + ")\r\n";
+    send(clientFd, line.data(), line.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    close(clientFd);
+}
+
+/*
+** adoptConnection(int clientFd, uint32_t peerAddr) [PRIVATE]
+** Takes charge of an accepted, non-blocking client socket:
+** 1. Registers it with the event backend (read events, or a multishot
+**    receive for a completion backend)
+** 2. Creates its record in the connection table
+** The caller reports it as a new connection.
+*/
+void    NetworkManager::adoptConnection(int clientFd, uint32_t peerAddr)
+{
+    _backend->addConnection(clientFd);
+    if (_shards != NULL)
+        _shards->setOwner(clientFd, _shardId);
+    Connection* conn = _connections.add(clientFd);
+    conn->peerAddr = peerAddr;
+    conn->floodTokens = _floodBurst;
+    conn->floodStamp = _now;
+    counterAdd(_metrics.connectionsAccepted, 1);
+    counterAdd(_metrics.connections, 1);
+    TRACE_INSTANT(TRACE_ACCEPT, clientFd, peerAddr, 0);
+}
+
+/*
+** adoptSocket(int fd)
+** Hands a connected stream socket made outside the server (typically
+** one end of a socketpair(AF_UNIX)) over to this manager, as if it had
+** been accepted: made non-blocking and close-on-exec, reported by the
+** next pollEvents() as a new connection, closed by the manager from
+** then on. It counts as a loopback peer (127.0.0.1): the host limits
+** do not apply.
+**
+** Throws: std::runtime_error before initialize()/initializeDetached()
+*/
+void    NetworkManager::adoptSocket(int fd)
+{
+    if (_backend == NULL)
+        throw std::runtime_error("Error: network manager not initialized");
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    adoptConnection(fd, htonl(INADDR_LOOPBACK));
+    _adoptedConnections.push_back(fd);
+}
+
+/*
+** handleClientEvent(const IOEvent& event) [PRIVATE]
 ** Routes client socket events to appropriate handlers.
 **
 ** Priority order:
-** 1. POLLHUP/POLLERR → Disconnection (mark for cleanup)
-** 2. POLLIN → Incoming data (handleIncomingData)
-** 3. POLLOUT → Ready to send (handleOutgoingData)
+** 1. EVENT_ERROR → Disconnection (mark for cleanup)
+** 2. EVENT_READ → Incoming data (handleIncomingData)
+** 3. EVENT_WRITE → Ready to send (handleOutgoingData)
+** Completion backends report EVENT_DATA (receiveCompleted) and
+** EVENT_SENT (sendCompleted) instead; the received buffer goes back
+** to the backend whatever happens to the connection.
 **
 ** Single event can trigger multiple handlers (read + write).
 */
-void NetworkManager::handleClientEvent(size_t index)
+void NetworkManager::handleClientEvent(const IOEvent& event)
 {
-    if (_pollFds[index].revents & (POLLHUP | POLLERR))
+    Connection* conn = _connections.find(event.fd);
+
+    if (conn != NULL && !conn->closing)
     {
-        _disconnectedClients.push_back(_pollFds[index].fd);
-        return;
+        if (event.flags & EVENT_ERROR)
+            markDisconnected(*conn);
+        else if (event.flags & EVENT_DATA)
+            receiveCompleted(*conn, event.data, event.length);
+        else if (event.flags & EVENT_SENT)
+            sendCompleted(*conn, event.length);
+        else
+        {
+            if (event.flags & EVENT_READ)
+                handleIncomingData(*conn);
+            if (event.flags & EVENT_WRITE && !conn->closing)
+                handleOutgoingData(*conn);
+        }
     }
-    
-    if (_pollFds[index].revents & POLLIN)
-        handleIncomingData(index);
-    
-    if (_pollFds[index].revents & POLLOUT)
-        handleOutgoingData(index);
+    if (event.flags & EVENT_DATA)
+        _backend->releaseBuffer(event);
 }
 
 /*
-** handleIncomingData(size_t index) [PRIVATE]
-** Reads data from client socket and buffers it.
+** handleIncomingData(Connection& conn) [PRIVATE]
+** Reads data from client socket straight into its receive ring.
 **
-** Process:
-** 1. recv() up to 4096 bytes from client
-** 2. Append to _readBuffers[fd] (accumulates partial messages)
+** Process (repeated until drained, READ_BUDGET spent or ring full):
+** 1. readv() into the ring's free space (one or two spans), capped by
+**    what is left of this cycle's read budget
+** 2. Commit the bytes and put the connection on the dirty list so
+**    getCompleteLines() only frames sockets that received something
 ** 3. Handle special cases:
-**    - bytesRead > 0: Data received successfully
+**    - short read: socket drained, the next arrival raises a new edge
 **    - bytesRead == 0: Client closed connection (graceful)
-**    - bytesRead == -1: Error (mark disconnect unless EAGAIN/EWOULDBLOCK)
+**    - bytesRead == -1: EAGAIN/EWOULDBLOCK means drained, anything
+**      else marks the client for disconnect
+**    - budget spent: resume next cycle, so one firehose client cannot
+**      starve the others in a single loop iteration
+**    - ring full: resume once framing has released space (an
+**      edge-triggered backend would not report the fd again, a
+**      level-triggered one stops watching it so poll() does not spin)
 **
-** Buffer persists until complete IRC message (\r\n) extracted.
+** Bytes are never NUL-terminated or converted, so payloads containing
+** \0 are preserved. Data persists until a complete line is framed.
 */
-void NetworkManager::handleIncomingData(size_t index)
+void NetworkManager::handleIncomingData(Connection& conn)
 {
-    int clientFd = _pollFds[index].fd;
-    char buffer[4096];
-    int bytesRead = recv(clientFd, buffer, sizeof(buffer) - 1, 0);
+    struct iovec iov[2];
+    size_t  budget = READ_BUDGET;
+    TRACE_SCOPE(trace, TRACE_READ, conn.fd, 0, 0);
     
-    if (bytesRead > 0)
+    while (true)
     {
-        buffer[bytesRead] = '\0';
-        _readBuffers[clientFd] += buffer;
+        int spans = conn.readBuffer.getWritableSpans(iov);
+        if (spans == 0 || budget == 0)
+        {
+            conn.readPending = true;
+            if (spans != 0)
+                _pendingReads.push_back(conn.fd);
+            else
+                _backend->setReadInterest(conn.fd, false);
+            return ;
+        }
+        if (iov[0].iov_len >= budget)
+        {
+            iov[0].iov_len = budget;
+            spans = 1;
+        }
+        else if (spans == 2 && iov[0].iov_len + iov[1].iov_len > budget)
+            iov[1].iov_len = budget - iov[0].iov_len;
+        size_t wanted = iov[0].iov_len + (spans == 2 ? iov[1].iov_len : 0);
+        ssize_t bytesRead = readv(conn.fd, iov, spans);
+        
+        if (bytesRead > 0)
+        {
+            conn.readBuffer.commit(bytesRead);
+            counterAdd(_metrics.bytesIn, bytesRead);
+            TRACE_ADD(trace, bytesRead);
+            budget -= bytesRead;
+            if (!conn.dirty)
+            {
+                conn.dirty = true;
+                _dirtyConnections.push_back(conn.fd);
+            }
+            if ((size_t)bytesRead < wanted)
+                return ;
+        }
+        else if (bytesRead == 0)
+        {
+            markDisconnected(conn);
+            return ;
+        }
+        else
+        {
+            if (errno == EINTR)
+                continue ;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                markDisconnected(conn);
+            return ;
+        }
     }
-    else if (bytesRead == 0)
-        _disconnectedClients.push_back(clientFd);
-    else
+}
+
+/*
+** resumePendingReads() [PRIVATE]
+** Continues reads that stopped on the read budget or a full receive
+** ring. A ring that is still full (lines held back by flood control)
+** stays pending until framing releases space; a level-triggered
+** backend stops watching it meanwhile (see handleIncomingData()). With
+** a completion backend, the overflow is moved into the ring first
+** (resumeReceive).
+*/
+void    NetworkManager::resumePendingReads()
+{
+    if (_pendingReads.empty())
+        return ;
+
+    std::vector<int> pending;
+    pending.swap(_pendingReads);
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        Connection* conn = _connections.find(pending[i]);
+        if (conn == NULL || !conn->readPending || conn->readBuffer.full())
+            continue ;
+        conn->readPending = false;
+        if (!conn->closing && _completion)
+            resumeReceive(*conn);
+        else if (!conn->closing)
+        {
+            _backend->setReadInterest(conn->fd, true);
+            handleIncomingData(*conn);
+        }
+    }
+}
+
+/*
+** receiveCompleted(Connection& conn, const char* data, size_t length) [PRIVATE]
+** Completion backend counterpart of handleIncomingData(): length bytes
+** were already received into a backend buffer and are copied into the
+** receive ring. What does not fit waits in conn.overflow, and the
+** backend stops receiving for the connection until framing has made
+** room (the TCP backpressure of the readiness path).
+*/
+void    NetworkManager::receiveCompleted(Connection& conn, const char* data, size_t length)
+{
+    size_t stored = 0;
+    TRACE_SCOPE(trace, TRACE_READ, conn.fd, length, 0);
+
+    counterAdd(_metrics.bytesIn, length);
+    if (conn.overflow.empty())
+        stored = storeReceived(conn, data, length);
+    if (stored == length)
+        return ;
+    conn.overflow.append(data + stored, length - stored);
+    if (!conn.readPending)
+    {
+        conn.readPending = true;
+        _backend->setReadInterest(conn.fd, false);
+    }
+}
+
+/*
+** storeReceived(Connection& conn, const char* data, size_t length) [PRIVATE]
+** Copies as much of data as fits into the receive ring and puts the
+** connection on the dirty list.
+**
+** Returns: bytes stored
+*/
+size_t  NetworkManager::storeReceived(Connection& conn, const char* data, size_t length)
+{
+    struct iovec iov[2];
+    size_t  stored = 0;
+    int     spans = conn.readBuffer.getWritableSpans(iov);
+
+    for (int i = 0; i < spans && stored < length; i++)
+    {
+        size_t chunk = std::min(iov[i].iov_len, length - stored);
+        std::memcpy(iov[i].iov_base, data + stored, chunk);
+        stored += chunk;
+    }
+    if (stored == 0)
+        return (0);
+    conn.readBuffer.commit(stored);
+    if (!conn.dirty)
+    {
+        conn.dirty = true;
+        _dirtyConnections.push_back(conn.fd);
+    }
+    return (stored);
+}
+
+/*
+** resumeReceive(Connection& conn) [PRIVATE]
+** Drains the overflow into the ring once framing has made room, then
+** lets the backend receive again.
+*/
+void    NetworkManager::resumeReceive(Connection& conn)
+{
+    conn.overflow.erase(0, storeReceived(conn, conn.overflow.data(), conn.overflow.size()));
+    if (!conn.overflow.empty())
     {
-        if (errno != EAGAIN && errno != EWOULDBLOCK)
-            _disconnectedClients.push_back(clientFd);
+        conn.readPending = true;
+        return ;
     }
+    _backend->setReadInterest(conn.fd, true);
 }
 
 /*
-** handleOutgoingData(size_t index) [PRIVATE]
+** handleOutgoingData(Connection& conn) [PRIVATE]
 ** Sends queued messages when socket is writable.
 **
-** Process:
-** 1. Check if messages queued for this client
-** 2. send() front message from queue
-** 3. If successful, remove from queue
-** 4. If queue empty, stop monitoring POLLOUT (clear flag)
+** Process (repeated until the queue is empty or EAGAIN):
+** 1. Gather up to WRITE_BATCH queued messages into an iovec array,
+**    the head one starting at conn.writeOffset
+** 2. One sendmsg() for the whole batch
+** 3. Pop every fully sent message; a partially sent head keeps its
+**    place and the offset records how much of it already went out
+** 4. If queue empty, drop write interest in the backend
 **
-** Non-blocking send: If socket buffer full (EAGAIN), try next cycle.
-** Serious errors → mark client for disconnection.
+** Non-blocking send: If socket buffer full (EAGAIN), the backend
+** reports the fd writable again later. Serious errors → disconnect.
+** With a completion backend this only runs as the last flush of
+** removeClient(), and not while a submitted send owns the queue head.
 */
-void NetworkManager::handleOutgoingData(size_t index)
+void NetworkManager::handleOutgoingData(Connection& conn)
 {
-    int fd = _pollFds[index].fd;
-    
-    if (_writeQueues[fd].empty())
-        return;
-    
-    std::string& message = _writeQueues[fd].front();
-    int bytesSent = send(fd, message.c_str(), message.length(), 0);
+    std::deque<SharedBuffer>& queue = conn.writeQueue;
+    struct iovec    iov[WRITE_BATCH];
+    TRACE_SCOPE(trace, TRACE_WRITE, conn.fd, 0, 0);
     
-    if (bytesSent > 0)
+    while (!queue.empty() && !conn.sendInFlight)
     {
-        _writeQueues[fd].pop();
+        size_t count = 0;
+        for (std::deque<SharedBuffer>::iterator it = queue.begin();
+                it != queue.end() && count < WRITE_BATCH; ++it, ++count)
+        {
+            size_t skip = (count == 0) ? conn.writeOffset : 0;
+            iov[count].iov_base = const_cast<char*>(it->data()) + skip;
+            iov[count].iov_len = it->length() - skip;
+        }
+
+        struct msghdr   msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t bytesSent = sendmsg(conn.fd, &msg, MSG_NOSIGNAL);
         
-        if (_writeQueues[fd].empty())
-            _pollFds[index].events &= ~POLLOUT;
+        if (bytesSent == -1)
+        {
+            if (errno == EINTR)
+                continue ;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                markDisconnected(conn);
+            return ;
+        }
+        popSent(conn, bytesSent);
+        TRACE_ADD(trace, bytesSent);
+    }
+    if (conn.wantWrite)
+    {
+        _backend->setWriteInterest(conn.fd, false);
+        conn.wantWrite = false;
+    }
+}
+
+/*
+** popSent(Connection& conn, size_t sent) [PRIVATE]
+** Pops every fully sent message; a partially sent head keeps its place
+** and writeOffset records how much of it already went out.
+** A drained queue records how long its oldest byte waited (sendDelay).
+*/
+void    NetworkManager::popSent(Connection& conn, size_t sent)
+{
+    std::deque<SharedBuffer>& queue = conn.writeQueue;
+    bool    backlog = !queue.empty();
+
+    conn.sendQBytes -= sent;
+    counterAdd(_metrics.bytesOut, sent);
+    counterSub(_metrics.sendQBytes, sent);
+    while (!queue.empty() && sent >= queue.front().length() - conn.writeOffset)
+    {
+        sent -= queue.front().length() - conn.writeOffset;
+        conn.writeOffset = 0;
+        queue.pop_front();
     }
-    else if (bytesSent == -1)
+    conn.writeOffset += sent;
+    if (backlog && queue.empty())
+        _metrics.sendDelay.record(Metrics::clock() - conn.queuedAt);
+}
+
+/*
+** submitSends() [PRIVATE]
+** Completion backend: hands every connection that queued output since
+** the last cycle to the backend as one gathered send (up to WRITE_BATCH
+** queued buffers), all submitted by the coming wait(). One send per
+** connection is in flight at a time, which keeps the output in order
+** without linking requests; sendCompleted() submits the rest.
+*/
+void    NetworkManager::submitSends()
+{
+    for (size_t i = 0; i < _sendReady.size(); i++)
     {
-        if (errno != EAGAIN && errno != EWOULDBLOCK)
-            _disconnectedClients.push_back(fd);
+        Connection* conn = _connections.find(_sendReady[i]);
+        if (conn == NULL || conn->closing || !conn->wantWrite)
+            continue ;
+        conn->wantWrite = false;
+        if (conn->sendInFlight || conn->writeQueue.empty())
+            continue ;
+
+        _sendBatch.clear();
+        for (std::deque<SharedBuffer>::iterator it = conn->writeQueue.begin();
+                it != conn->writeQueue.end() && _sendBatch.size() < WRITE_BATCH; ++it)
+            _sendBatch.push_back(*it);
+        conn->sendInFlight = _backend->submitSend(conn->fd, &_sendBatch[0],
+            _sendBatch.size(), conn->writeOffset);
     }
+    _sendReady.clear();
+    _sendBatch.clear();
+}
+
+/*
+** sendCompleted(Connection& conn, size_t sent) [PRIVATE]
+** A submitted send finished: pop what went out and queue the next one
+** if output is left (a partial send resumes at writeOffset).
+*/
+void    NetworkManager::sendCompleted(Connection& conn, size_t sent)
+{
+    conn.sendInFlight = false;
+    popSent(conn, sent);
+    if (!conn.writeQueue.empty())
+        armWrite(conn);
+}
+
+/*
+** markDisconnected(Connection& conn) [PRIVATE]
+** Flags a connection for the next cleanup. Drops noticed during
+** pollEvents() are cleaned up and reported in the same cycle, drops
+** noticed later (from sendMessage()/removeClient()) in the next one.
+** The closing flag keeps an fd from being queued twice when several
+** paths (error event, recv() == 0, failed send) notice the same drop.
+*/
+void    NetworkManager::markDisconnected(Connection& conn)
+{
+    if (conn.closing)
+        return ;
+    conn.closing = true;
+    _pendingRemovals.push_back(conn.fd);
 }
 
 /*
@@ -248,13 +712,19 @@ void NetworkManager::handleOutgoingData(size_t index)
 ** Removes disconnected clients from all tracking structures.
 **
 ** For each disconnected fd:
-** 1. Remove from _pollFds (stop monitoring)
-** 2. Erase from _readBuffers (free partial message data)
-** 3. Erase from _writeQueues (discard pending messages)
-** 4. close() socket file descriptor
+** 1. Remove from the event backend (stop monitoring)
+** 2. Swap-remove its record from the connection table (frees the
+**    partial read buffer and discards pending messages)
+** 3. Release its slot in the per-address accounting, and queue the
+**    close() for the start of the next pollEvents()
 **
 ** Called at end of pollEvents() after all events processed.
 ** Ensures safe removal without disrupting iteration.
+** The close is deferred because the kernel reuses a closed fd number
+** at once, possibly in another reactor's accept(): until the IRC layer
+** has dropped its state for the fd (after this pollEvents()), channel
+** fan-out and forwarded output may still address it. An fd that stays
+** open cannot be handed out again.
 */
 void    NetworkManager::cleanupDisconnectedClients()
 {
@@ -262,104 +732,735 @@ void    NetworkManager::cleanupDisconnectedClients()
     {
         int fd = _disconnectedClients[i];
         
-        for (size_t j = 0; j < _pollFds.size(); j++)
+        Connection* conn = _connections.find(fd);
+        if (conn == NULL)
+            continue ;
+        if (_shards != NULL)
+            _shards->releaseHost(conn->peerAddr);
+        else
+            _hostLimits.release(conn->peerAddr);
+        counterSub(_metrics.sendQBytes, conn->sendQBytes);
+        counterSub(_metrics.connections, 1);
+        counterAdd(_metrics.connectionsClosed, 1);
+        TRACE_INSTANT(TRACE_CLOSE, fd, 0, 0);
+        _backend->removeFd(fd);
+        _connections.remove(fd);
+        _deferredCloses.push_back(fd);
+    }
+}
+
+/*
+** closeDeferred() [PRIVATE]
+** Closes the fds cleanupDisconnectedClients() retired last cycle; only
+** now may another shard accept the same number.
+*/
+void    NetworkManager::closeDeferred()
+{
+    for (size_t i = 0; i < _deferredCloses.size(); i++)
+    {
+        if (_shards != NULL)
+            _shards->setOwner(_deferredCloses[i], -1);
+        close(_deferredCloses[i]);
+    }
+    _deferredCloses.clear();
+}
+
+/*
+** receiveForwarded() [PRIVATE]
+** Queues what other shards sent to our fds (see ShardGroup). Lines for
+** connections that closed meanwhile are dropped.
+*/
+void    NetworkManager::receiveForwarded()
+{
+    ShardMessage* node = _shards->receive(_shardId);
+
+    while (node != NULL)
+    {
+        for (size_t i = 0; i < node->fds.size(); i++)
         {
-            if (_pollFds[j].fd == fd)
-            {
-                _pollFds.erase(_pollFds.begin() + j);
-                break;
-            }
+            Connection* conn = _connections.find(node->fds[i]);
+            if (conn != NULL)
+                sendShared(*conn, node->line, SEND_NORMAL);
         }
-        
-        _readBuffers.erase(fd);
-        _writeQueues.erase(fd);
-        
-        close(fd);
+        ShardMessage* next = node->next;
+        delete node;
+        node = next;
     }
 }
 
 /*
-** getCompleteMessages()
-** Extracts complete IRC messages from read buffers.
+** getCompleteLines()
+** Frames complete IRC lines out of the receive rings, without copying.
 **
-** IRC message format: Must end with \r\n
+** IRC message format: Must end with \r\n, at most MAX_LINE_LENGTH
 ** 
 ** Process:
-** - Iterates through all _readBuffers
-** - Finds messages ending with \r\n
-** - Extracts and returns them as (fd, message) pairs
-** - Leaves partial messages in buffer for next cycle
+** - Visits connections on the dirty list (received bytes this cycle)
+**   and throttled ones (complete lines held back by flood control);
+**   a partial line elsewhere cannot have been completed
+** - Each complete line becomes a LineView into the ring and is
+**   released from it (bytes stay readable until the next pollEvents())
 **
-** Returns: Vector of (file descriptor, complete message) pairs
-** Note: Single buffer can yield multiple messages
+** Returns: Lines in arrival order per connection, valid until the next
+**          pollEvents() call
 */
-std::vector<std::pair<int, std::string> >   NetworkManager::getCompleteMessages()
+const std::vector<LineView>&    NetworkManager::getCompleteLines()
 {
-    std::vector<std::pair<int, std::string> > messages;
+    _lines.clear();
     
-    for (std::map<int, std::string>::iterator it = _readBuffers.begin();
-            it != _readBuffers.end(); ++it)
+    std::vector<int> throttled;
+    throttled.swap(_throttledConnections);
+    for (size_t i = 0; i < throttled.size(); i++)
+    {
+        Connection* conn = _connections.find(throttled[i]);
+        if (conn == NULL)
+            continue ;
+        conn->throttled = false;
+        if (!conn->dirty)
+            frameLines(*conn);
+    }
+    for (size_t i = 0; i < _dirtyConnections.size(); i++)
+    {
+        Connection* conn = _connections.find(_dirtyConnections[i]);
+        if (conn == NULL)
+            continue ;
+        conn->dirty = false;
+        frameLines(*conn);
+    }
+    _dirtyConnections.clear();
+    counterAdd(_metrics.linesIn, _lines.size());
+    return (_lines);
+}
+
+/*
+** frameLines(Connection& conn) [PRIVATE]
+** Moves one connection's complete lines to _lines.
+**
+** Inbound limits:
+** - A line longer than MAX_LINE_LENGTH is dropped; if MAX_LINE_LENGTH
+**   bytes are buffered without a terminator, they are discarded and
+**   so is everything up to the next \r\n (the receive buffer stays
+**   bounded no matter what the client sends)
+** - Each line costs a flood token; without one, the rest stays in the
+**   ring and the connection is revisited when a token is earned
+**   (TCP backpressure slows the client once its ring fills up)
+*/
+void    NetworkManager::frameLines(Connection& conn)
+{
+    LineView    view;
+    view.fd = conn.fd;
+    
+    while (conn.readBuffer.nextLine(view.data, view.length))
+    {
+        if (conn.discarding || view.length > MAX_LINE_LENGTH)
+        {
+            conn.discarding = false;
+            conn.readBuffer.consume(view.length);
+            continue ;
+        }
+        if (!takeFloodToken(conn))
+        {
+            conn.throttled = true;
+            _throttledConnections.push_back(conn.fd);
+            break ;
+        }
+        _lines.push_back(view);
+        conn.readBuffer.consume(view.length);
+    }
+    if (!conn.throttled && conn.readBuffer.size() >= MAX_LINE_LENGTH)
     {
-        int fd = it->first;
-        std::string& buffer = it->second;
+        conn.readBuffer.clear();
+        conn.discarding = true;
+    }
+    if (conn.readPending && !conn.readBuffer.full())
+        _pendingReads.push_back(conn.fd);
+}
 
-        size_t  pos;
-        while ((pos = buffer.find("\r\n")) != std::string::npos)
+/*
+** takeFloodToken(Connection& conn) [PRIVATE]
+** RFC 1459-style flood control as a token bucket: a client may burst
+** _floodBurst lines, then earns one line every _floodRefillMs.
+** Disabled when _floodBurst is 0; exempt connections always pass.
+**
+** Returns: true if the line may be processed now
+*/
+bool    NetworkManager::takeFloodToken(Connection& conn)
+{
+    if (_floodBurst == 0 || conn.floodExempt)
+        return (true);
+    if (conn.floodTokens < _floodBurst)
+    {
+        unsigned long earned = (_now - conn.floodStamp) / _floodRefillMs;
+        if (earned > 0)
         {
-           std::string message = buffer.substr(0, pos + 2);
-           messages.push_back(std::make_pair(fd, message));
-           buffer.erase(0, pos + 2); 
+            conn.floodStamp += earned * _floodRefillMs;
+            conn.floodTokens = std::min((unsigned long)_floodBurst, conn.floodTokens + earned);
         }
     }
+    if (conn.floodTokens == 0)
+        return (false);
+    if (conn.floodTokens == _floodBurst)
+        conn.floodStamp = _now;
+    conn.floodTokens--;
+    return (true);
+}
+
+/*
+** computeTimeout() [PRIVATE]
+** Timeout for the next backend wait():
+** - 0 when reads, removals or accepts are pending
+** - otherwise the earliest of: the next timer (TimerWheel), the next
+**   accept retry after descriptor exhaustion, the time until the
+**   earliest throttled client earns a token
+** - -1 (block) when there is none
+*/
+int NetworkManager::computeTimeout()
+{
+    if (!_pendingReads.empty() || !_pendingRemovals.empty() || _acceptPending)
+        return (0);
+
+    unsigned long now = monotonicMs();
+    int timeout = _timers.nextTimeout(now);
+    if (_acceptRetryAt != 0)
+    {
+        if (_acceptRetryAt <= now)
+            return (0);
+        if (timeout == -1 || (unsigned long)timeout > _acceptRetryAt - now)
+            timeout = _acceptRetryAt - now;
+    }
+    if (_throttledConnections.empty())
+        return (timeout);
+
+    unsigned long wait = _floodRefillMs;
+    for (size_t i = 0; i < _throttledConnections.size(); i++)
+    {
+        Connection* conn = _connections.find(_throttledConnections[i]);
+        if (conn == NULL)
+            continue ;
+        unsigned long due = conn->floodStamp + _floodRefillMs;
+        if (due <= now)
+            return (0);
+        wait = std::min(wait, due - now);
+    }
+    if (timeout != -1 && (unsigned long)timeout < wait)
+        return (timeout);
+    return (wait);
+}
+
+unsigned long   NetworkManager::monotonicMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000UL + ts.tv_nsec / 1000000UL);
+}
+
+/*
+** getCompleteMessages()
+** Owning variant of getCompleteLines() for callers that keep lines
+** past the next pollEvents().
+**
+** Returns: Vector of (file descriptor, complete message) pairs
+*/
+std::vector<std::pair<int, std::string> >   NetworkManager::getCompleteMessages()
+{
+    const std::vector<LineView>& lines = getCompleteLines();
+    std::vector<std::pair<int, std::string> > messages;
+    
+    messages.reserve(lines.size());
+    for (size_t i = 0; i < lines.size(); i++)
+        messages.push_back(std::make_pair(lines[i].fd,
+            std::string(lines[i].data, lines[i].length)));
     return (messages);
 }
 
 /*
-** sendMessage(int clientFd, const std::string& message)
-** Queues message for transmission to specific client.
+** sendMessage(int clientFd, const std::string& message, SendPriority priority)
+** Sends or queues message for transmission to specific client.
 **
 ** Process:
-** 1. Add message to client's write queue
-** 2. Enable POLLOUT monitoring (tells poll to notify when writable)
-** 3. Actual send happens in handleOutgoingData() when socket ready
+** 1. Output already queued: the message must fit the SendQ budget,
+**    otherwise the SendQ policy drops it or disconnects the client
+** 2. Nothing queued: try send() right away, which is the common case
+**    and skips a whole poll round-trip (and any allocation)
+** 3. Whatever could not be written (all of it if output is already
+**    queued) is copied into the last queued chunk when it has room,
+**    or into a fresh OUTPUT_CHUNK_SIZE chunk
+** 4. The rest is sent in handleOutgoingData() when socket ready
 **
 ** Queue-based design prevents blocking on full socket buffers.
 ** Messages sent in FIFO order.
 */
-void    NetworkManager::sendMessage(int clientFd, const std::string& message)
+void    NetworkManager::sendMessage(int clientFd, const std::string& message,
+            SendPriority priority)
+{
+    Connection* conn = _connections.find(clientFd);
+    if (conn == NULL && _shards != NULL && !message.empty())
+        _shards->forward(_shardId, clientFd, message.data(), message.length());
+    if (conn == NULL || conn->closing || message.empty())
+        return ;
+    if (!admitToSendQ(*conn, message.length(), priority))
+        return ;
+
+    ssize_t written = sendDirect(*conn, message.data(), message.length());
+    if (written == -1 || written == (ssize_t)message.length())
+        return ;
+    enqueueCopy(*conn, message.data() + written, message.length() - written);
+}
+
+/*
+** sendMessage(int clientFd, const SharedBuffer& message, SendPriority priority)
+** Same as above for an already serialized message. Channel broadcasts
+** build one SharedBuffer and pass it to every member: queuing it only
+** takes a reference, the bytes are never copied per recipient.
+*/
+void    NetworkManager::sendMessage(int clientFd, const SharedBuffer& message,
+            SendPriority priority)
 {
-    _writeQueues[clientFd].push(message);
-    for (size_t i = 0; i < _pollFds.size(); i++)
+    Connection* conn = _connections.find(clientFd);
+    if (conn == NULL && _shards != NULL && !message.empty())
+        _shards->forward(_shardId, clientFd, message);
+    if (conn == NULL || conn->closing || message.empty())
+        return ;
+    sendShared(*conn, message, priority);
+}
+
+/*
+** sendShared(Connection& conn, const SharedBuffer& message, SendPriority priority) [PRIVATE]
+** Direct write, then a reference to the rest on the queue.
+*/
+void    NetworkManager::sendShared(Connection& conn, const SharedBuffer& message,
+            SendPriority priority)
+{
+    if (conn.closing || message.empty() || !admitToSendQ(conn, message.length(), priority))
+        return ;
+
+    ssize_t written = sendDirect(conn, message.data(), message.length());
+    if (written == -1 || written == (ssize_t)message.length())
+        return ;
+    enqueue(conn, message, written);
+}
+
+/*
+** beginReply(int clientFd)
+** Hands out space for one line (MAX_LINE_LENGTH bytes) so a reply can
+** be formatted in place (see ReplyBuilder), without temporaries:
+** - nothing queued: a scratch buffer, sent directly by commitReply()
+** - output queued: the free tail of the last queued chunk (a fresh
+**   chunk is queued if it has no room)
+** Must be followed by commitReply() before any other send to the fd.
+**
+** Returns: writable buffer, never NULL (a scratch area for dead fds)
+*/
+char*   NetworkManager::beginReply(int clientFd)
+{
+    Connection* conn = _connections.find(clientFd);
+    if (conn == NULL || conn->closing || conn->writeQueue.empty())
+        return (_replyScratch);
+
+    if (conn->writeQueue.back().spare() < MAX_LINE_LENGTH)
+        conn->writeQueue.push_back(SharedBuffer::allocate(OUTPUT_CHUNK_SIZE));
+    return (conn->writeQueue.back().tail());
+}
+
+/*
+** commitReply(int clientFd, size_t length, SendPriority priority)
+** Publishes the length bytes formatted since beginReply(), subject to
+** the SendQ like any other message. A reply that is not published
+** (empty, shed by the SendQ policy, client closing) gives back the
+** chunk beginReply() queued for it, if it did: lagging clients, those
+** that shed, would otherwise pile up empty chunks.
+*/
+void    NetworkManager::commitReply(int clientFd, size_t length, SendPriority priority)
+{
+    Connection* conn = _connections.find(clientFd);
+    if (conn == NULL && _shards != NULL && length != 0)
+        _shards->forward(_shardId, clientFd, _replyScratch, length);
+    if (conn == NULL)
+        return ;
+    if (conn->closing || length == 0 || !admitToSendQ(*conn, length, priority))
+    {
+        if (conn->writeQueue.size() > 1 && conn->writeQueue.back().length() == 0)
+            conn->writeQueue.pop_back();
+        return ;
+    }
+
+    if (conn->writeQueue.empty())
+    {
+        ssize_t written = sendDirect(*conn, _replyScratch, length);
+        if (written == -1 || written == (ssize_t)length)
+            return ;
+        enqueueCopy(*conn, _replyScratch + written, length - written);
+        return ;
+    }
+    conn->writeQueue.back().extend(length);
+    conn->sendQBytes += length;
+    counterAdd(_metrics.sendQBytes, length);
+    armWrite(*conn);
+}
+
+/*
+** sendGather(int clientFd, const struct iovec* parts, size_t count, SendPriority priority)
+** Sends the concatenation of parts as one message: a single sendmsg()
+** when nothing is queued, whatever it did not take is copied to the
+** write queue. Lets callers assemble output from pre-rendered pieces
+** without joining them first (see RegistrationBurst).
+*/
+void    NetworkManager::sendGather(int clientFd, const struct iovec* parts, size_t count,
+            SendPriority priority)
+{
+    Connection* conn = _connections.find(clientFd);
+    if (conn == NULL && _shards != NULL)
     {
-        if (_pollFds[i].fd == clientFd)
+        for (size_t i = 0; i < count; i++)
+            if (parts[i].iov_len > 0)
+                _shards->forward(_shardId, clientFd,
+                    static_cast<const char*>(parts[i].iov_base), parts[i].iov_len);
+    }
+    if (conn == NULL || conn->closing)
+        return ;
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++)
+        total += parts[i].iov_len;
+    if (total == 0 || !admitToSendQ(*conn, total, priority))
+        return ;
+
+    size_t written = 0;
+    if (conn->writeQueue.empty() && !_completion)
+    {
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = const_cast<struct iovec*>(parts);
+        msg.msg_iovlen = std::min(count, (size_t)IOV_MAX);
+
+        ssize_t bytesSent;
+        do
+            bytesSent = sendmsg(conn->fd, &msg, MSG_NOSIGNAL);
+        while (bytesSent == -1 && errno == EINTR);
+
+        if (bytesSent == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            markDisconnected(*conn);
+            return ;
+        }
+        if (bytesSent > 0)
         {
-            _pollFds[i].events |= POLLOUT;
-            break ; 
+            written = bytesSent;
+            counterAdd(_metrics.bytesOut, written);
         }
     }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (written >= parts[i].iov_len)
+        {
+            written -= parts[i].iov_len;
+            continue ;
+        }
+        enqueueCopy(*conn, static_cast<const char*>(parts[i].iov_base) + written,
+            parts[i].iov_len - written);
+        written = 0;
+    }
 }
 
-bool    NetworkManager::isValidSocket(int fd)
+/*
+** sendDirect(Connection& conn, const char* data, size_t length) [PRIVATE]
+** Writes immediately when nothing is queued ahead of this message.
+** Never with a completion backend: output is queued and submitted in
+** one batch per cycle instead of one send() per message.
+**
+** Returns: bytes written (0 if output is queued or the socket is full),
+**          -1 if the connection died (already marked for cleanup)
+*/
+ssize_t NetworkManager::sendDirect(Connection& conn, const char* data, size_t length)
 {
-    for (size_t i = 0; i < _pollFds.size(); i++)
+    if (!conn.writeQueue.empty() || _completion)
+        return (0);
+
+    ssize_t bytesSent;
+    do
+        bytesSent = send(conn.fd, data, length, MSG_NOSIGNAL);
+    while (bytesSent == -1 && errno == EINTR);
+
+    if (bytesSent >= 0)
     {
-        if (_pollFds[i].fd == fd)
-            return (true);
+        counterAdd(_metrics.bytesOut, bytesSent);
+        return (bytesSent);
     }
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return (0);
+    markDisconnected(conn);
+    return (-1);
+}
+
+/*
+** admitToSendQ(Connection& conn, size_t bytes, SendPriority priority) [PRIVATE]
+** Enforces the per-connection SendQ: bytes may be queued only while the
+** unsent total stays within _sendQLimit. An empty queue always admits
+** (the message is written directly). Over budget, the SendQ policy
+** decides; without one the client is disconnected.
+**
+** Returns: true if the message may be sent/queued
+*/
+bool    NetworkManager::admitToSendQ(Connection& conn, size_t bytes, SendPriority priority)
+{
+    if (conn.writeQueue.empty() || conn.sendQBytes + bytes <= _sendQLimit)
+        return (true);
+
+    SendQAction action = SENDQ_DISCONNECT;
+    if (_sendQPolicy != NULL)
+        action = _sendQPolicy->onSendQExceeded(conn.fd, conn.sendQBytes, bytes, priority);
+    if (action == SENDQ_DISCONNECT)
+        markDisconnected(conn);
     return (false);
 }
 
+/*
+** enqueue(Connection& conn, const SharedBuffer& message, size_t written) [PRIVATE]
+** Appends a reference to the message to the write queue. written is how
+** much of it sendDirect() already sent (it is then the queue head).
+*/
+void    NetworkManager::enqueue(Connection& conn, const SharedBuffer& message, size_t written)
+{
+    if (conn.writeQueue.empty())
+        conn.queuedAt = Metrics::clock();
+    conn.writeQueue.push_back(message);
+    conn.sendQBytes += message.length() - written;
+    counterAdd(_metrics.sendQBytes, message.length() - written);
+    if (conn.writeQueue.size() == 1)
+        conn.writeOffset = written;
+    armWrite(conn);
+}
+
+/*
+** enqueueCopy(Connection& conn, const char* data, size_t length) [PRIVATE]
+** Queues a private copy of data. Small messages are appended to the
+** last queued chunk while it is unshared and has room, so a backlog of
+** replies is a few OUTPUT_CHUNK_SIZE blocks rather than one allocation
+** per line.
+*/
+void    NetworkManager::enqueueCopy(Connection& conn, const char* data, size_t length)
+{
+    if (conn.writeQueue.empty())
+        conn.queuedAt = Metrics::clock();
+    if (conn.writeQueue.empty() || conn.writeQueue.back().spare() < length)
+        conn.writeQueue.push_back(SharedBuffer::allocate(std::max(length, (size_t)OUTPUT_CHUNK_SIZE)));
+    
+    SharedBuffer& chunk = conn.writeQueue.back();
+    std::memcpy(chunk.tail(), data, length);
+    chunk.extend(length);
+    conn.sendQBytes += length;
+    counterAdd(_metrics.sendQBytes, length);
+    armWrite(conn);
+}
+
+/*
+** armWrite(Connection& conn) [PRIVATE]
+** Enables write interest on the empty → non-empty queue transition
+** only (one epoll_ctl per burst, not per message). A completion
+** backend instead gets the connection in the next submitSends().
+*/
+void    NetworkManager::armWrite(Connection& conn)
+{
+    if (conn.wantWrite)
+        return ;
+    conn.wantWrite = true;
+    if (_completion)
+        _sendReady.push_back(conn.fd);
+    else
+        _backend->setWriteInterest(conn.fd, true);
+}
+
+bool    NetworkManager::isValidSocket(int fd)
+{
+    Connection* conn = _connections.find(fd);
+    return (conn != NULL && !conn->closing);
+}
+
+/*
+** sendFinal(int clientFd, const std::string& message)
+** Last words to a client dropped over its SendQ (from the SendQ
+** policy): written straight to the socket, ahead of the queued output
+** that the disconnect discards. Best effort: skipped in the middle of a
+** partially sent line or while a completion send owns the socket, lost
+** if the socket buffer is full.
+*/
+void    NetworkManager::sendFinal(int clientFd, const std::string& message)
+{
+    Connection* conn = _connections.find(clientFd);
+    if (conn == NULL || conn->closing || conn->writeOffset != 0 || conn->sendInFlight)
+        return ;
+
+    ssize_t bytesSent;
+    do
+        bytesSent = send(clientFd, message.data(), message.length(), MSG_NOSIGNAL);
+    while (bytesSent == -1 && errno == EINTR);
+    if (bytesSent > 0)
+        counterAdd(_metrics.bytesOut, bytesSent);
+}
+
+/*
+** removeClient(int fd)
+** Requests disconnection of a client from the IRC layer (QUIT, KICK of
+** a dead link...). Queued output gets a last flush attempt, then the fd
+** is closed and reported by getDisconnectedClients() on the next cycle.
+*/
 void    NetworkManager::removeClient(int fd)
 {
-    _disconnectedClients.push_back(fd);
+    Connection* conn = _connections.find(fd);
+    if (conn == NULL || conn->closing)
+        return ;
+
+    handleOutgoingData(*conn);
+    markDisconnected(*conn);
 }
 
-std::vector<int> NetworkManager::getNewClients()
+/*
+** getNewClients() / getDisconnectedClients()
+** This cycle's connects and drops. Like getCompleteLines(), the lists
+** live in the manager and are cleared, not freed, by the next
+** pollEvents(): their storage is reused every cycle.
+*/
+const std::vector<int>& NetworkManager::getNewClients() const
 {
     return (_newConnections);
 }
 
-std::vector<int> NetworkManager::getDisconnectedClients()
+const std::vector<int>& NetworkManager::getDisconnectedClients() const
 {
     return (_disconnectedClients);
+}
+
+/*
+** getExpiredTimers()
+** Owners (as given to TimerWheel::create()) of the timers that fired
+** during the last pollEvents(). The timers are disarmed, not freed.
+*/
+const std::vector<unsigned int>&    NetworkManager::getExpiredTimers() const
+{
+    return (_expiredTimers);
+}
+
+/*
+** getTimers() / getTime()
+** The loop's timer wheel, and the monotonic time in ms of the last
+** wakeup (what the wheel was turned to; cheaper than a clock read).
+*/
+TimerWheel& NetworkManager::getTimers()
+{
+    return (_timers);
+}
+
+unsigned long   NetworkManager::getTime() const
+{
+    return (_now);
+}
+
+/*
+** getCycleStart()
+** Returns: when this cycle's wait returned (ns, Metrics::clock()), the
+**          start of the work the loop-time histogram measures
+*/
+unsigned long   NetworkManager::getCycleStart() const
+{
+    return (_cycleStart);
+}
+
+/*
+** getMetrics()
+** This loop's metrics: written by the loop only, read by anyone (see
+** Metrics).
+*/
+Metrics&    NetworkManager::getMetrics()
+{
+    return (_metrics);
+}
+
+void    NetworkManager::setSendQLimit(size_t bytes)
+{
+    _sendQLimit = bytes;
+}
+
+void    NetworkManager::setSendQPolicy(ISendQPolicy* policy)
+{
+    _sendQPolicy = policy;
+}
+
+size_t  NetworkManager::getSendQLimit() const
+{
+    return (_sendQLimit);
+}
+
+/*
+** getSendQueueBytes(int fd) / getSendQueueLength(int fd)
+** Per-client output backlog (unsent bytes / queued messages), used to
+** spot lagging clients.
+*/
+size_t  NetworkManager::getSendQueueBytes(int fd)
+{
+    Connection* conn = _connections.find(fd);
+    return (conn != NULL ? conn->sendQBytes : 0);
+}
+
+size_t  NetworkManager::getSendQueueLength(int fd)
+{
+    Connection* conn = _connections.find(fd);
+    return (conn != NULL ? conn->writeQueue.size() : 0);
+}
+
+/*
+** setFloodControl(unsigned int burst, unsigned long refillMs)
+** Token bucket parameters for inbound lines; burst 0 disables it.
+*/
+void    NetworkManager::setFloodControl(unsigned int burst, unsigned long refillMs)
+{
+    _floodBurst = burst;
+    _floodRefillMs = (refillMs == 0) ? 1 : refillMs;
+}
+
+void    NetworkManager::setFloodExempt(int fd, bool exempt)
+{
+    Connection* conn = _connections.find(fd);
+    if (conn != NULL)
+        conn->floodExempt = exempt;
+}
+
+/*
+** setHostLimits(unsigned int maxPerHost, unsigned int burst, unsigned long refillMs)
+** Per-address limits: concurrent connections, then a token bucket of
+** connection attempts (burst, then one per refillMs). 0 disables one.
+** In a shard group they are the group's, shared by every shard.
+*/
+void    NetworkManager::setHostLimits(unsigned int maxPerHost, unsigned int burst,
+            unsigned long refillMs)
+{
+    _hostLimits.setLimits(maxPerHost, burst, refillMs);
+    if (_shards != NULL)
+        _shards->setHostLimits(maxPerHost, burst, refillMs);
+}
+
+/*
+** getPeerHost(int fd)
+** Numeric address of the client on fd ("" if unknown). No reverse DNS:
+** a blocking resolver has no place in the event loop.
+*/
+std::string NetworkManager::getPeerHost(int fd)
+{
+    Connection*     conn = _connections.find(fd);
+    char            host[INET_ADDRSTRLEN];
+    struct in_addr  addr;
+
+    if (conn == NULL)
+        return ("");
+    addr.s_addr = conn->peerAddr;
+    if (inet_ntop(AF_INET, &addr, host, sizeof(host)) == NULL)
+        return ("");
+    return (host);
+}
+
+const char* NetworkManager::getBackendName() const
+{
+    if (_backend == NULL)
+        return ("none");
+    return (_backend->getName());
 }
\ No newline at end of file
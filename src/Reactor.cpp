@@ -0,0 +1,426 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Reactor.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:31:14 by odana             #+#    #+#             */
+/*   Updated: 2026/10/19 13:31:14 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/Reactor.hpp"
+#include "../inc/IRCServer.hpp"
+#include "../inc/commands/PassCommand.hpp"
+#include "../inc/commands/NickCommand.hpp"
+#include "../inc/commands/UserCommand.hpp"
+#include "../inc/commands/PingCommand.hpp"
+#include "../inc/commands/PongCommand.hpp"
+#include "../inc/commands/StatsCommand.hpp"
+#include "../inc/ReplyBuilder.hpp"
+#include <sstream>
+#include <iostream>
+
+CycleTimes::CycleTimes()
+    : cycles(0), lines(0), poll(0), frame(0), parse(0), execute(0), other(0) {}
+
+Reactor::Reactor(IRCServer& server, unsigned int id)
+    : _server(server), _id(id), _commandEngine(_networkManager),
+    _registrationBurst(_networkManager, MOTD_PATH), _motdGeneration(0),
+    _traceGeneration(0) {}
+
+/*
+** initialize(int port, ShardGroup* shards, EventBackendType backend)
+** Registers the commands, renders the registration burst, plugs the
+** SendQ policy into the network layer and opens the listening socket
+** (as shard _id of shards, if not NULL) on the given event backend.
+*/
+void    Reactor::initialize(int port, ShardGroup* shards, EventBackendType backend)
+{
+    setup(shards);
+    _networkManager.initialize(port, backend);
+}
+
+/*
+** initializeDetached(EventBackendType backend)
+** A loop without listener, fed through adoptSocket(): an in-process
+** server for benchmarks and tests, driven cycle by cycle with
+** runCycle() (see bench/pipebench.cpp).
+*/
+void    Reactor::initializeDetached(EventBackendType backend)
+{
+    setup(NULL);
+    _networkManager.initializeDetached(backend);
+}
+
+/*
+** adoptSocket(int fd)
+** Serves a connected socket made outside the server (one end of a
+** socketpair()); the client appears on the next cycle.
+*/
+void    Reactor::adoptSocket(int fd)
+{
+    _networkManager.adoptSocket(fd);
+}
+
+void    Reactor::setup(ShardGroup* shards)
+{
+    registerCommands();
+    _motdGeneration = _server.getMotdGeneration();
+    _traceGeneration = _server.getTraceGeneration();
+    _registrationBurst.reload();
+    _networkManager.setSendQPolicy(this);
+    if (!_server.isFloodControlEnabled())
+        _networkManager.setFloodControl(0, FLOOD_REFILL_MS);
+    if (shards != NULL)
+        _networkManager.attachShardGroup(shards, _id);
+}
+
+void    Reactor::registerCommands()
+{
+    UserRegistry&   users = _server.getUserRegistry();
+
+    _commandEngine.registerCommand("PASS", new PassCommand(_networkManager, _server.getPassword()));
+    _commandEngine.registerCommand("NICK",
+        new NickCommand(_networkManager, users, _registrationBurst));
+    _commandEngine.registerCommand("USER",
+        new UserCommand(_networkManager, users, _registrationBurst));
+    _commandEngine.registerCommand("PING", new PingCommand(_networkManager));
+    _commandEngine.registerCommand("PONG", new PongCommand());
+    _commandEngine.registerCommand("STATS", new StatsCommand(_networkManager, _server));
+}
+
+/*
+** run()
+** Event loop, on the calling thread, until the server stops.
+*/
+void    Reactor::run()
+{
+    TRACE_THREAD("reactor", _id);
+    while (_server.isRunning())
+        runCycle();
+}
+
+/*
+** runCycle(CycleTimes* times)
+** One turn of the loop: wait for network events, frame and parse the
+** lines, then hand the results of the cycle to the IRC layer in order
+** (connects, lines, timeouts, disconnects) under the state lock. Only
+** that last step is serialized between loops.
+** A SIGHUP bumps the MOTD generation and wakes every loop, each one
+** re-renders its burst. In a traced build, loop 0 also writes the trace
+** rings out after a SIGUSR2 (see dumpTrace()).
+** With times, the time of each stage is added to it (two clock reads
+** per stage, nothing otherwise).
+*/
+void    Reactor::runCycle(CycleTimes* times)
+{
+    unsigned long   start = (times != NULL) ? Metrics::clock() : 0;
+    unsigned long   dispatched = 0;
+
+    _networkManager.pollEvents();
+    if (_motdGeneration != _server.getMotdGeneration())
+    {
+        _motdGeneration = _server.getMotdGeneration();
+        _registrationBurst.reload();
+    }
+#ifdef IRCSERV_TRACE
+    if (_id == 0 && _traceGeneration != _server.getTraceGeneration())
+    {
+        _traceGeneration = _server.getTraceGeneration();
+        dumpTrace();
+    }
+#endif
+    unsigned long   polled = (times != NULL) ? Metrics::clock() : 0;
+
+    const std::vector<LineView>& lines = _networkManager.getCompleteLines();
+    TRACE_SCOPE(trace, TRACE_DISPATCH, -1, lines.size(), 0);
+
+    if (times != NULL)
+    {
+        unsigned long framed = Metrics::clock();
+        times->cycles++;
+        times->lines += lines.size();
+        times->poll += polled - start;
+        times->frame += framed - polled;
+        dispatched = times->parse + times->execute;
+        start = framed;
+    }
+    parseLines(lines, times);
+
+    _server.lockState();
+    handleNewConnections();
+    handleMessages(lines.size(), times);
+    handleTimeouts();
+    handleDisconnections();
+    _server.unlockState();
+    _networkManager.getMetrics().loopTime.record(
+        Metrics::clock() - _networkManager.getCycleStart());
+    if (times != NULL)
+        times->other += Metrics::clock() - start
+            - (times->parse + times->execute - dispatched);
+}
+
+/*
+** dumpTrace() [PRIVATE]
+** Writes every thread's trace ring to ircserv-trace-<pid>-<n>.json in
+** the working directory (n: SIGUSR2 count). This loop stalls for the
+** write, the others keep serving and tracing.
+*/
+void    Reactor::dumpTrace()
+{
+    std::ostringstream  path;
+
+    path << "ircserv-trace-" << getpid() << "-" << _traceGeneration << ".json";
+    if (TraceLog::dump(path.str()))
+        std::cerr << "Trace written to " << path.str() << std::endl;
+    else
+        std::cerr << "Error: cannot write " << path.str() << std::endl;
+}
+
+/*
+** threadMain(void* reactor) [PRIVATE]
+** Thread entry of a shard. A failing loop stops the whole server.
+*/
+void*   Reactor::threadMain(void* reactor)
+{
+    Reactor* self = static_cast<Reactor*>(reactor);
+
+    try
+    {
+        self->run();
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Error: reactor " << self->_id << ": " << e.what() << std::endl;
+        self->_server.shutdown();
+    }
+    return (NULL);
+}
+
+/*
+** getMetrics()
+** This loop's metrics (owned by its NetworkManager), readable from any
+** thread.
+*/
+Metrics&    Reactor::getMetrics()
+{
+    return (_networkManager.getMetrics());
+}
+
+/*
+** start()
+** Runs the loop on a new thread.
+**
+** Throws: std::runtime_error if the thread cannot be created
+*/
+void    Reactor::start()
+{
+    if (pthread_create(&_thread, NULL, threadMain, this) != 0)
+        throw std::runtime_error("Error: reactor thread creation failed");
+}
+
+void    Reactor::join()
+{
+    pthread_join(_thread, NULL);
+}
+
+/*
+** onSendQExceeded(int fd, size_t queuedBytes, size_t messageBytes, SendPriority priority)
+** SendQ policy: low-priority traffic is shed for a lagging client,
+** anything else means the client cannot keep up and is dropped. Like
+** closeLink(), it is told why (ERROR, best effort: its socket is full).
+** May run outside the state lock (forwarded output), hence only
+** network-layer state here.
+*/
+SendQAction Reactor::onSendQExceeded(int fd, size_t queuedBytes,
+    size_t messageBytes, SendPriority priority)
+{
+    (void)queuedBytes;
+    (void)messageBytes;
+    if (priority == SEND_LOW)
+        return (SENDQ_DROP);
+    _networkManager.sendFinal(fd, "ERROR :Closing Link: "
+        + _networkManager.getPeerHost(fd) + " (Max SendQ exceeded)\r\n");
+    return (SENDQ_DISCONNECT);
+}
+
+/*
+** handleNewConnections()
+** Creates the IRC state of the clients accepted this cycle; each gets
+** its timer in this loop's wheel, first armed with the registration
+** deadline. The timer reports the client's handle, not its fd.
+*/
+void    Reactor::handleNewConnections()
+{
+    const std::vector<int>& fds = _networkManager.getNewClients();
+    TimerWheel&     timers = _networkManager.getTimers();
+    unsigned long   now = _networkManager.getTime();
+
+    for (size_t i = 0; i < fds.size(); i++)
+    {
+        Client* client = _server.getUserRegistry().createClient(fds[i]);
+        if (client == NULL)
+        {
+            _networkManager.removeClient(fds[i]);
+            continue ;
+        }
+        if ((size_t)fds[i] >= _clientsByFd.size())
+            _clientsByFd.resize(fds[i] + 1, INVALID_CLIENT);
+        _clientsByFd[fds[i]] = client->getHandle();
+        client->setHostname(_networkManager.getPeerHost(fds[i]));
+        client->setLastActivity(now);
+        client->setTimer(timers.create(client->getHandle()));
+        timers.arm(client->getTimer(), now + REGISTRATION_TIMEOUT_MS);
+    }
+}
+
+/*
+** findClient(int fd) [PRIVATE]
+** Returns: the client on one of this loop's fds, NULL if none
+*/
+Client* Reactor::findClient(int fd)
+{
+    if (fd < 0 || (size_t)fd >= _clientsByFd.size())
+        return (NULL);
+    return (_server.getUserRegistry().getClient(_clientsByFd[fd]));
+}
+
+/*
+** parseLines(const std::vector<LineView>& lines, CycleTimes* times)
+** Parses the cycle's lines into _parsed, before the state lock is
+** taken: parsing only reads the receive rings, so the loops do it in
+** parallel. Slots are reused from cycle to cycle (parseView() rewrites
+** the whole view).
+*/
+void    Reactor::parseLines(const std::vector<LineView>& lines, CycleTimes* times)
+{
+    unsigned long   start = (times != NULL) ? Metrics::clock() : 0;
+
+    if (_parsed.size() < lines.size())
+        _parsed.resize(lines.size());
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        ParsedLine& parsed = _parsed[i];
+
+        parsed.fd = lines[i].fd;
+        parsed.valid = MessageProcessor::parseView(lines[i].data, lines[i].length, parsed.view);
+        if (!parsed.valid)
+            counterAdd(_networkManager.getMetrics().parseErrors, 1);
+    }
+    if (times != NULL)
+        times->parse += Metrics::clock() - start;
+}
+
+/*
+** handleMessages(size_t count, CycleTimes* times)
+** Runs the command of each of the first count parsed lines. Any line,
+** even one that does not parse, counts as activity for the keepalive:
+** it only stores a timestamp, the timer itself is not touched (see
+** handleTimeouts()).
+** Lines of a client dropped earlier in the batch (wrong PASS, SendQ)
+** are skipped: its IRC state goes away next cycle.
+** With times, execution is timed.
+*/
+void    Reactor::handleMessages(size_t count, CycleTimes* times)
+{
+    unsigned long   now = _networkManager.getTime();
+    unsigned long   start = (times != NULL) ? Metrics::clock() : 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const ParsedLine&   parsed = _parsed[i];
+        Client*             client = findClient(parsed.fd);
+
+        if (client == NULL || !_networkManager.isValidSocket(parsed.fd))
+            continue ;
+        client->setLastActivity(now);
+        if (parsed.valid)
+            _commandEngine.execute(client, parsed.view);
+    }
+    if (times != NULL)
+        times->execute += Metrics::clock() - start;
+}
+
+/*
+** handleTimeouts()
+** One timer per client, whose meaning follows its state:
+** - not registered yet: the registration deadline passed → closed
+** - PING outstanding: nothing received since it was sent → closed
+**   ("Ping timeout"), otherwise the client is alive again
+** - registered: idle for PING_INTERVAL_MS → PING, answer expected
+**   within PING_TIMEOUT_MS
+** Activity is only a timestamp, so a busy client costs no timer work
+** per line: when its timer fires early, it is re-armed for
+** PING_INTERVAL_MS after the last line.
+*/
+void    Reactor::handleTimeouts()
+{
+    const std::vector<unsigned int>&    owners = _networkManager.getExpiredTimers();
+    TimerWheel&     timers = _networkManager.getTimers();
+    unsigned long   now = _networkManager.getTime();
+
+    for (size_t i = 0; i < owners.size(); i++)
+    {
+        Client* client = _server.getUserRegistry().getClient(owners[i]);
+        if (client == NULL)
+            continue ;
+        unsigned long pingSentAt = client->getPingSentAt();
+
+        if (client->getState() != REGISTERED)
+            closeLink(client, "Registration timed out");
+        else if (pingSentAt != 0 && client->getLastActivity() <= pingSentAt)
+        {
+            std::ostringstream  reason;
+            reason << "Ping timeout: " << (now - client->getLastActivity()) / 1000 << " seconds";
+            closeLink(client, reason.str());
+        }
+        else if (now - client->getLastActivity() >= PING_INTERVAL_MS)
+        {
+            ReplyBuilder(_networkManager, client->getFd()).command("PING")
+                .trailing(SERVER_NAME).send();
+            client->setPingSentAt(now);
+            timers.arm(client->getTimer(), now + PING_TIMEOUT_MS);
+        }
+        else
+        {
+            client->setPingSentAt(0);
+            timers.arm(client->getTimer(), client->getLastActivity() + PING_INTERVAL_MS);
+        }
+    }
+}
+
+/*
+** closeLink(Client* client, const std::string& reason) [PRIVATE]
+** Server-side drop: ERROR to the client, then the usual disconnect
+** path.
+*/
+void    Reactor::closeLink(Client* client, const std::string& reason)
+{
+    ReplyBuilder(_networkManager, client->getFd()).command("ERROR")
+        .trailing("Closing Link: " + client->getHostname() + " (" + reason + ")").send();
+    _networkManager.removeClient(client->getFd());
+}
+
+/*
+** handleDisconnections()
+** Drops the IRC state of clients the network layer closed this cycle.
+*/
+void    Reactor::handleDisconnections()
+{
+    const std::vector<int>& gone = _networkManager.getDisconnectedClients();
+    UserRegistry&   users = _server.getUserRegistry();
+
+    for (size_t i = 0; i < gone.size(); i++)
+    {
+        Client* client = findClient(gone[i]);
+        if (client != NULL)
+        {
+            _networkManager.getTimers().destroy(client->getTimer());
+            _server.getChannelRegistry().removeUserFromAll(client);
+            users.removeClient(client->getHandle());
+            _clientsByFd[gone[i]] = INVALID_CLIENT;
+        }
+    }
+}
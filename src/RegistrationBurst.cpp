@@ -0,0 +1,239 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RegistrationBurst.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:31:02 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 15:31:02 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/RegistrationBurst.hpp"
+#include <cstdio>
+#include <ctime>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+RegistrationBurst::RegistrationBurst(NetworkManager& networkManager,
+    const std::string& motdPath)
+    : _networkManager(networkManager), _motdPath(motdPath)
+{
+    char    date[64];
+    time_t  now = time(NULL);
+
+    if (strftime(date, sizeof(date), "%a %b %d %Y at %H:%M:%S", localtime(&now)) == 0)
+        date[0] = '\0';
+    _created = date;
+}
+
+/*
+** text(const char* data, size_t length) [PRIVATE]
+** Appends static bytes to the template, extending the current segment
+** (a new one starts after a slot).
+*/
+void    RegistrationBurst::text(const char* data, size_t length)
+{
+    if (_segments.empty() || _segments.back().slot != SLOT_NONE)
+    {
+        Segment segment = { _template.length(), 0, SLOT_NONE };
+        _segments.push_back(segment);
+    }
+    _template.append(data, length);
+    _segments.back().length += length;
+}
+
+void    RegistrationBurst::text(const char* data)
+{
+    text(data, std::strlen(data));
+}
+
+/*
+** slot(Slot slot) [PRIVATE]
+** Marks the current template position as filled per client.
+*/
+void    RegistrationBurst::slot(Slot slot)
+{
+    if (_segments.empty() || _segments.back().slot != SLOT_NONE)
+    {
+        Segment segment = { _template.length(), 0, SLOT_NONE };
+        _segments.push_back(segment);
+    }
+    _segments.back().slot = slot;
+}
+
+/*
+** numeric(int code) [PRIVATE]
+** Starts a numeric line: ":ircserv CODE <nick> "
+*/
+void    RegistrationBurst::numeric(int code)
+{
+    text(SERVER_PREFIX, SERVER_PREFIX_LENGTH);
+    text(MessageProcessor::numericCode(code), 3);
+    text(" ", 1);
+    slot(SLOT_NICK);
+    text(" ", 1);
+}
+
+/*
+** reload()
+** (Re)renders the whole burst. Called at startup and on SIGHUP; cheap
+** enough to run on the event loop thread.
+*/
+void    RegistrationBurst::reload()
+{
+    _template.clear();
+    _segments.clear();
+
+    numeric(1);
+    text(":Welcome to the ft_irc Network ");
+    slot(SLOT_NICK);
+    text("\r\n");
+    numeric(2);
+    text(":Your host is " SERVER_NAME ", running version " SERVER_VERSION "\r\n");
+    numeric(3);
+    text(":This server was created ");
+    text(_created.c_str());
+    text("\r\n");
+    numeric(4);
+    text(SERVER_NAME " " SERVER_VERSION " o iklot\r\n");
+    numeric(5);
+    text("CHANTYPES=# PREFIX=(o)@ CHANMODES=,k,l,it NICKLEN=9 CASEMAPPING=rfc1459"
+        " :are supported by this server\r\n");
+
+    numeric(251);
+    text(":There are ");
+    slot(SLOT_USERS);
+    text(" users and 0 services on 1 servers\r\n");
+    numeric(255);
+    text(":I have ");
+    slot(SLOT_USERS);
+    text(" clients and 0 servers\r\n");
+
+    renderMotd();
+}
+
+/*
+** renderMotd() [PRIVATE]
+** Maps the MOTD file and renders one 372 line per line of it, between
+** 375 and 376. The mapping only lives for the render: the template
+** keeps its own copy, so the file may change freely until the next
+** reload(). No file (or an unreadable one) → 422 ERR_NOMOTD.
+*/
+void    RegistrationBurst::renderMotd()
+{
+    int fd = open(_motdPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        numeric(422);
+        text(":MOTD File is missing\r\n");
+        return ;
+    }
+
+    struct stat st;
+    const char* data = NULL;
+    size_t      size = 0;
+    bool        readable = (fstat(fd, &st) == 0);
+
+    if (readable && st.st_size > 0)
+    {
+        void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+            readable = false;
+        else
+        {
+            data = static_cast<const char*>(map);
+            size = st.st_size;
+        }
+    }
+    close(fd);
+    if (!readable)
+    {
+        numeric(422);
+        text(":MOTD File is missing\r\n");
+        return ;
+    }
+
+    numeric(375);
+    text(":- " SERVER_NAME " Message of the day - \r\n");
+    size_t pos = 0;
+    while (pos < size)
+    {
+        const char* newline = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+        size_t      end = (newline != NULL) ? newline - data : size;
+        size_t      length = end - pos;
+
+        if (length > 0 && data[pos + length - 1] == '\r')
+            length--;
+        if (length > MOTD_LINE_MAX)
+            length = MOTD_LINE_MAX;
+        numeric(372);
+        text(":- ", 3);
+        text(data + pos, length);
+        text("\r\n", 2);
+        pos = end + 1;
+    }
+    numeric(376);
+    text(":End of MOTD command\r\n");
+
+    if (data != NULL)
+        munmap(const_cast<char*>(data), size);
+}
+
+/*
+** send(const Client& client, size_t userCount)
+** Sends the burst to client as a single gathered write.
+*/
+void    RegistrationBurst::send(const Client& client, size_t userCount)
+{
+    char    users[24];
+    int     usersLength = std::sprintf(users, "%lu", static_cast<unsigned long>(userCount));
+    const std::string&  nick = client.getNickname();
+
+    _parts.clear();
+    for (size_t i = 0; i < _segments.size(); i++)
+    {
+        const Segment&  segment = _segments[i];
+        struct iovec    part;
+
+        if (segment.length > 0)
+        {
+            part.iov_base = const_cast<char*>(_template.data() + segment.offset);
+            part.iov_len = segment.length;
+            _parts.push_back(part);
+        }
+        if (segment.slot == SLOT_NICK)
+        {
+            part.iov_base = const_cast<char*>(nick.data());
+            part.iov_len = nick.length();
+            _parts.push_back(part);
+        }
+        else if (segment.slot == SLOT_USERS)
+        {
+            part.iov_base = users;
+            part.iov_len = usersLength;
+            _parts.push_back(part);
+        }
+    }
+    if (!_parts.empty())
+        _networkManager.sendGather(client.getFd(), &_parts[0], _parts.size());
+}
+
+/*
+** completeRegistration(Client* client, UserRegistry& users)
+** Promotes the client to REGISTERED once PASS, NICK and USER are all
+** in, and welcomes it. LUSERS counts registered clients only, this one
+** included: connections still registering are not users.
+**
+** Returns: true if the client just became registered
+*/
+bool    RegistrationBurst::completeRegistration(Client* client, UserRegistry& users)
+{
+    if (client->getState() == REGISTERED || !client->isPasswordVerified()
+        || client->getNickname().empty() || client->getUsername().empty())
+        return (false);
+    users.markRegistered(client);
+    send(*client, users.getRegisteredCount());
+    return (true);
+}
@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ReplyBuilder.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:55:02 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 11:55:02 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/ReplyBuilder.hpp"
+
+ReplyBuilder::ReplyBuilder(NetworkManager& networkManager, int fd)
+    : _networkManager(networkManager), _fd(fd), _length(0)
+{
+    _out = _networkManager.beginReply(fd);
+}
+
+/*
+** append(const char* data, size_t length) [PRIVATE]
+** Copies as much as fits, keeping 2 bytes for the final \r\n.
+*/
+void    ReplyBuilder::append(const char* data, size_t length)
+{
+    size_t room = MAX_LINE_LENGTH - 2 - _length;
+    if (length > room)
+        length = room;
+    std::memcpy(_out + _length, data, length);
+    _length += length;
+}
+
+/*
+** numeric(int code, const std::string& target)
+** Starts a server numeric: ":ircserv CODE target"
+*/
+ReplyBuilder&   ReplyBuilder::numeric(int code, const std::string& target)
+{
+    append(SERVER_PREFIX, SERVER_PREFIX_LENGTH);
+    append(MessageProcessor::numericCode(code), 3);
+    append(" ", 1);
+    append(target.data(), target.length());
+    return (*this);
+}
+
+/*
+** source(const std::string& prefix)
+** Starts a relayed message: ":nick!user@host"
+*/
+ReplyBuilder&   ReplyBuilder::source(const std::string& prefix)
+{
+    append(":", 1);
+    append(prefix.data(), prefix.length());
+    return (*this);
+}
+
+ReplyBuilder&   ReplyBuilder::command(const char* command)
+{
+    if (_length != 0)
+        append(" ", 1);
+    append(command, std::strlen(command));
+    return (*this);
+}
+
+ReplyBuilder&   ReplyBuilder::param(const std::string& param)
+{
+    append(" ", 1);
+    append(param.data(), param.length());
+    return (*this);
+}
+
+ReplyBuilder&   ReplyBuilder::param(const StringSlice& param)
+{
+    append(" ", 1);
+    append(param.data, param.length);
+    return (*this);
+}
+
+ReplyBuilder&   ReplyBuilder::trailing(const std::string& text)
+{
+    append(" :", 2);
+    append(text.data(), text.length());
+    return (*this);
+}
+
+ReplyBuilder&   ReplyBuilder::trailing(const char* text)
+{
+    append(" :", 2);
+    append(text, std::strlen(text));
+    return (*this);
+}
+
+ReplyBuilder&   ReplyBuilder::trailing(const StringSlice& text)
+{
+    append(" :", 2);
+    append(text.data, text.length);
+    return (*this);
+}
+
+/*
+** send(SendPriority priority)
+** Terminates the line and publishes it to the connection.
+*/
+void    ReplyBuilder::send(SendPriority priority)
+{
+    _out[_length++] = '\r';
+    _out[_length++] = '\n';
+    _networkManager.commitReply(_fd, _length, priority);
+}
@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RingBuffer.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 13:09:15 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 13:09:15 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/RingBuffer.hpp"
+#include <cstring>
+#include <algorithm>
+
+#define RING_MASK (RING_BUFFER_SIZE - 1)
+
+RingBuffer::RingBuffer() : _data(NULL), _head(0), _tail(0), _scanned(0) {}
+
+RingBuffer::RingBuffer(const RingBuffer& other)
+    : _data(NULL), _head(0), _tail(0), _scanned(0)
+{
+    *this = other;
+}
+
+RingBuffer& RingBuffer::operator=(const RingBuffer& other)
+{
+    if (this == &other)
+        return (*this);
+    if (other._data != NULL)
+    {
+        if (_data == NULL)
+            _data = new char[RING_BUFFER_SIZE];
+        std::memcpy(_data, other._data, RING_BUFFER_SIZE);
+    }
+    _head = other._head;
+    _tail = other._tail;
+    _scanned = other._scanned;
+    return (*this);
+}
+
+RingBuffer::~RingBuffer()
+{
+    delete[] _data;
+}
+
+size_t  RingBuffer::size() const
+{
+    return (_tail - _head);
+}
+
+size_t  RingBuffer::available() const
+{
+    return (RING_BUFFER_SIZE - size());
+}
+
+bool    RingBuffer::full() const
+{
+    return (size() == RING_BUFFER_SIZE);
+}
+
+char    RingBuffer::at(size_t offset) const
+{
+    return (_data[(_head + offset) & RING_MASK]);
+}
+
+/*
+** getWritableSpans(struct iovec iov[2])
+** Describes the free space as at most two contiguous regions, ready
+** for readv(). Allocates the storage on first call.
+**
+** Returns: number of iovecs filled (0 when the ring is full)
+*/
+int RingBuffer::getWritableSpans(struct iovec iov[2])
+{
+    if (_data == NULL)
+        _data = new char[RING_BUFFER_SIZE];
+
+    size_t free = available();
+    if (free == 0)
+        return (0);
+
+    size_t start = _tail & RING_MASK;
+    size_t first = std::min(free, (size_t)RING_BUFFER_SIZE - start);
+    iov[0].iov_base = _data + start;
+    iov[0].iov_len = first;
+    if (first == free)
+        return (1);
+    iov[1].iov_base = _data;
+    iov[1].iov_len = free - first;
+    return (2);
+}
+
+void    RingBuffer::commit(size_t bytes)
+{
+    _tail += bytes;
+}
+
+/*
+** nextLine(const char*& line, size_t& length)
+** Finds the next \r\n-terminated line without consuming it.
+** Scanning resumes where the previous unsuccessful call stopped, so a
+** line delivered byte by byte is scanned once, not once per byte.
+**
+** Returns: true with line/length (terminator included) set, pointing
+**          into the ring or into _spill for a line that wraps
+*/
+bool    RingBuffer::nextLine(const char*& line, size_t& length)
+{
+    size_t  used = size();
+    size_t  offset = _scanned;
+
+    while (offset < used)
+    {
+        size_t  start = (_head + offset) & RING_MASK;
+        size_t  span = std::min(used - offset, (size_t)RING_BUFFER_SIZE - start);
+        const char* nl = static_cast<const char*>(std::memchr(_data + start, '\n', span));
+        if (nl == NULL)
+        {
+            offset += span;
+            continue ;
+        }
+        offset += (nl - (_data + start));
+        if (offset > 0 && at(offset - 1) == '\r')
+        {
+            length = offset + 1;
+            size_t first = _head & RING_MASK;
+            if (first + length <= RING_BUFFER_SIZE)
+                line = _data + first;
+            else
+            {
+                size_t part = RING_BUFFER_SIZE - first;
+                _spill.resize(length);
+                std::memcpy(&_spill[0], _data + first, part);
+                std::memcpy(&_spill[part], _data, length - part);
+                line = &_spill[0];
+            }
+            return (true);
+        }
+        offset++;
+    }
+    _scanned = used;
+    return (false);
+}
+
+/*
+** consume(size_t bytes)
+** Releases bytes from the front. An emptied ring rewinds to offset 0
+** so the next lines land contiguously and rarely need _spill.
+*/
+void    RingBuffer::consume(size_t bytes)
+{
+    _head += bytes;
+    _scanned = 0;
+    if (_head == _tail)
+    {
+        _head = 0;
+        _tail = 0;
+    }
+}
+
+void    RingBuffer::clear()
+{
+    _head = 0;
+    _tail = 0;
+    _scanned = 0;
+}
+
+void    RingBuffer::swap(RingBuffer& other)
+{
+    std::swap(_data, other._data);
+    std::swap(_head, other._head);
+    std::swap(_tail, other._tail);
+    std::swap(_scanned, other._scanned);
+    _spill.swap(other._spill);
+}
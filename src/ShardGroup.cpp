@@ -0,0 +1,278 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ShardGroup.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:22:51 by odana             #+#    #+#             */
+/*   Updated: 2026/10/19 10:22:51 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/ShardGroup.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef __linux__
+# include <sys/eventfd.h>
+#endif
+
+#define MAX_TRACKED_FDS (1 << 20)
+
+ShardGroup::ShardGroup(unsigned int count)
+{
+    pthread_mutex_init(&_hostLock, NULL);
+#ifndef __linux__
+    (void)count;
+    throw std::runtime_error("Error: multi-reactor mode needs eventfd (Linux)");
+#else
+    struct rlimit   limit;
+    size_t          fds = 65536;
+
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+        fds = std::min((size_t)limit.rlim_cur, (size_t)MAX_TRACKED_FDS);
+    _owners.assign(fds, -1);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        Shard* shard = new Shard;
+        shard->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        shard->staged.assign(count, NULL);
+        shard->posted.assign(count, false);
+        _shards.push_back(shard);
+        if (shard->wakeFd == -1)
+            throw std::runtime_error("Error: eventfd creation failed");
+    }
+#endif
+}
+
+ShardGroup::~ShardGroup()
+{
+    for (size_t i = 0; i < _shards.size(); i++)
+    {
+        Shard* shard = _shards[i];
+        for (size_t j = 0; j < shard->staged.size(); j++)
+            delete shard->staged[j];
+        for (ShardMessage* node = shard->inbox.takeAll(); node != NULL; )
+        {
+            ShardMessage* next = node->next;
+            delete node;
+            node = next;
+        }
+        if (shard->wakeFd != -1)
+            close(shard->wakeFd);
+        delete shard;
+    }
+    pthread_mutex_destroy(&_hostLock);
+}
+
+unsigned int    ShardGroup::size() const
+{
+    return (_shards.size());
+}
+
+int ShardGroup::getWakeFd(unsigned int shard) const
+{
+    return (_shards[shard]->wakeFd);
+}
+
+/*
+** admitHost(uint32_t addr, unsigned long nowMs) / releaseHost(uint32_t addr)
+** HostLimiter::admit() / release() on the group's table: a host gets
+** the limits once, not once per shard. Taken per accept and per close
+** of a non-loopback client (loopback skips the lock), never per line.
+*/
+HostVerdict ShardGroup::admitHost(uint32_t addr, unsigned long nowMs)
+{
+    if (HostLimiter::isExempt(addr))
+        return (HOST_ADMIT);
+    pthread_mutex_lock(&_hostLock);
+    HostVerdict verdict = _hostLimits.admit(addr, nowMs);
+    pthread_mutex_unlock(&_hostLock);
+    return (verdict);
+}
+
+void    ShardGroup::releaseHost(uint32_t addr)
+{
+    if (HostLimiter::isExempt(addr))
+        return ;
+    pthread_mutex_lock(&_hostLock);
+    _hostLimits.release(addr);
+    pthread_mutex_unlock(&_hostLock);
+}
+
+void    ShardGroup::setHostLimits(unsigned int maxPerHost, unsigned int burst,
+            unsigned long refillMs)
+{
+    pthread_mutex_lock(&_hostLock);
+    _hostLimits.setLimits(maxPerHost, burst, refillMs);
+    pthread_mutex_unlock(&_hostLock);
+}
+
+/*
+** setOwner(int fd, int shard)
+** Called by the accepting shard (shard -1 right before it closes the
+** fd, which another shard may then accept again). Other shards only
+** learn about a connection through the shared IRC state, under its
+** lock, so they always see the owner; the atomics keep the concurrent
+** updates of a reused fd's entry well-defined.
+*/
+void    ShardGroup::setOwner(int fd, int shard)
+{
+    if (fd >= 0 && (size_t)fd < _owners.size())
+        __atomic_store_n(&_owners[fd], shard, __ATOMIC_RELEASE);
+}
+
+int ShardGroup::getOwner(int fd) const
+{
+    if (fd < 0 || (size_t)fd >= _owners.size())
+        return (-1);
+    return (__atomic_load_n(&_owners[fd], __ATOMIC_ACQUIRE));
+}
+
+/*
+** stage(unsigned int from, unsigned int to) [PRIVATE]
+** Returns: the node from is building for to, NULL if none
+*/
+ShardMessage*   ShardGroup::stage(unsigned int from, unsigned int to)
+{
+    return (_shards[from]->staged[to]);
+}
+
+/*
+** post(unsigned int to, ShardMessage* message) [PRIVATE]
+** Hands a staged node over to its destination. The reference to the
+** source buffer is dropped first: it belongs to the sending thread.
+*/
+void    ShardGroup::post(unsigned int to, ShardMessage* message)
+{
+    message->source = SharedBuffer();
+    _shards[to]->inbox.push(message);
+}
+
+/*
+** forward(unsigned int from, int fd, const SharedBuffer& line)
+** Sends a shared line to an fd of another shard. Consecutive forwards
+** of the same buffer to the same shard (a broadcast) add the fd to one
+** staged node holding a single copy.
+**
+** Returns: false if the fd has no other owner (the caller drops it)
+*/
+bool    ShardGroup::forward(unsigned int from, int fd, const SharedBuffer& line)
+{
+    int to = getOwner(fd);
+    if (to < 0 || (unsigned int)to == from)
+        return (false);
+
+    ShardMessage*   node = stage(from, to);
+    if (node != NULL && !node->source.empty() && node->source.data() == line.data())
+    {
+        node->fds.push_back(fd);
+        return (true);
+    }
+    if (node != NULL)
+    {
+        post(to, node);
+        _shards[from]->posted[to] = true;
+    }
+
+    node = new ShardMessage;
+    node->next = NULL;
+    node->line = SharedBuffer(line.data(), line.length());
+    node->source = line;
+    node->fds.push_back(fd);
+    _shards[from]->staged[to] = node;
+    return (true);
+}
+
+/*
+** forward(unsigned int from, int fd, const char* data, size_t length)
+** Sends a private message (reply, PRIVMSG) to an fd of another shard.
+** Consecutive messages to the same fd are appended to one node.
+**
+** Returns: false if the fd has no other owner (the caller drops it)
+*/
+bool    ShardGroup::forward(unsigned int from, int fd, const char* data, size_t length)
+{
+    int to = getOwner(fd);
+    if (to < 0 || (unsigned int)to == from)
+        return (false);
+
+    ShardMessage*   node = stage(from, to);
+    if (node == NULL || !node->source.empty() || node->fds.size() != 1
+        || node->fds[0] != fd || node->line.spare() < length)
+    {
+        if (node != NULL)
+        {
+            post(to, node);
+            _shards[from]->posted[to] = true;
+        }
+        node = new ShardMessage;
+        node->next = NULL;
+        node->line = SharedBuffer::allocate(std::max(length, (size_t)SHARD_CHUNK_SIZE));
+        node->fds.push_back(fd);
+        _shards[from]->staged[to] = node;
+    }
+    std::memcpy(node->line.tail(), data, length);
+    node->line.extend(length);
+    return (true);
+}
+
+/*
+** flush(unsigned int from)
+** Posts everything from staged and wakes each destination once. Called
+** by the sending shard before it blocks.
+*/
+void    ShardGroup::flush(unsigned int from)
+{
+    Shard* shard = _shards[from];
+
+    for (unsigned int to = 0; to < shard->staged.size(); to++)
+    {
+        if (shard->staged[to] != NULL)
+        {
+            post(to, shard->staged[to]);
+            shard->staged[to] = NULL;
+            shard->posted[to] = true;
+        }
+        if (shard->posted[to])
+        {
+            wake(to);
+            shard->posted[to] = false;
+        }
+    }
+}
+
+/*
+** receive(unsigned int shard)
+** Consumer side, on the shard's own thread: clears the wakeup first so
+** a post racing with it raises a new one, then takes the inbox.
+**
+** Returns: posted nodes, oldest first; the caller deletes them
+*/
+ShardMessage*   ShardGroup::receive(unsigned int shard)
+{
+#ifdef __linux__
+    eventfd_t   count;
+
+    while (eventfd_read(_shards[shard]->wakeFd, &count) == 0)
+        ;
+#endif
+    return (_shards[shard]->inbox.takeAll());
+}
+
+/*
+** wake(unsigned int shard)
+** Interrupts the shard's event wait (eventfd becomes readable).
+*/
+void    ShardGroup::wake(unsigned int shard)
+{
+#ifdef __linux__
+    eventfd_write(_shards[shard]->wakeFd, 1);
+#else
+    (void)shard;
+#endif
+}
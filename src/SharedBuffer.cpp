@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SharedBuffer.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 15:36:02 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 15:36:02 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/SharedBuffer.hpp"
+#include <cstring>
+#include <new>
+
+SharedBuffer::SharedBuffer() : _block(NULL) {}
+
+/*
+** SharedBuffer(const char* data, size_t length)
+** Copies the bytes once into a fresh block holding one reference.
+*/
+SharedBuffer::SharedBuffer(const char* data, size_t length) : _block(NULL)
+{
+    if (length != 0)
+        create(data, length, length);
+}
+
+SharedBuffer::SharedBuffer(const std::string& bytes) : _block(NULL)
+{
+    if (!bytes.empty())
+        create(bytes.data(), bytes.length(), bytes.length());
+}
+
+/*
+** allocate(size_t capacity)
+** Empty, appendable buffer with room for capacity bytes.
+*/
+SharedBuffer    SharedBuffer::allocate(size_t capacity)
+{
+    SharedBuffer buffer;
+    buffer.create(NULL, 0, capacity);
+    return (buffer);
+}
+
+/*
+** create(const char* data, size_t length, size_t capacity) [PRIVATE]
+** Allocates header + capacity bytes in one block, holding one reference.
+*/
+void    SharedBuffer::create(const char* data, size_t length, size_t capacity)
+{
+    void* raw = ::operator new(offsetof(Block, data) + capacity);
+    _block = static_cast<Block*>(raw);
+    _block->refs = 1;
+    _block->length = length;
+    _block->capacity = capacity;
+    if (length != 0)
+        std::memcpy(_block->data, data, length);
+}
+
+SharedBuffer::SharedBuffer(const SharedBuffer& other) : _block(other._block)
+{
+    if (_block != NULL)
+        _block->refs++;
+}
+
+SharedBuffer&   SharedBuffer::operator=(const SharedBuffer& other)
+{
+    if (_block == other._block)
+        return (*this);
+    if (other._block != NULL)
+        other._block->refs++;
+    release();
+    _block = other._block;
+    return (*this);
+}
+
+SharedBuffer::~SharedBuffer()
+{
+    release();
+}
+
+/*
+** release() [PRIVATE]
+** Drops this reference, freeing the block with the last one.
+*/
+void    SharedBuffer::release()
+{
+    if (_block != NULL && --_block->refs == 0)
+        ::operator delete(_block);
+    _block = NULL;
+}
+
+const char* SharedBuffer::data() const
+{
+    return (_block != NULL ? _block->data : "");
+}
+
+size_t  SharedBuffer::length() const
+{
+    return (_block != NULL ? _block->length : 0);
+}
+
+bool    SharedBuffer::empty() const
+{
+    return (length() == 0);
+}
+
+size_t  SharedBuffer::useCount() const
+{
+    return (_block != NULL ? _block->refs : 0);
+}
+
+/*
+** spare()
+** Returns: bytes that may still be appended, 0 once the buffer is shared
+*/
+size_t  SharedBuffer::spare() const
+{
+    if (_block == NULL || _block->refs != 1)
+        return (0);
+    return (_block->capacity - _block->length);
+}
+
+/*
+** tail() / extend(size_t bytes)
+** Write position past the current bytes, and publishes bytes written
+** there. Only valid while spare() covers them.
+*/
+char*   SharedBuffer::tail()
+{
+    return (_block->data + _block->length);
+}
+
+void    SharedBuffer::extend(size_t bytes)
+{
+    _block->length += bytes;
+}
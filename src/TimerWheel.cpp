@@ -0,0 +1,255 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TimerWheel.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:12:40 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 20:12:40 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/TimerWheel.hpp"
+#include <climits>
+
+TimerWheel::TimerWheel(unsigned long nowMs) : _current(nowMs / TIMER_TICK_MS), _armed(0)
+{
+    for (int i = 0; i < TIMER_LEVELS * TIMER_SLOTS; i++)
+        _heads[i] = -1;
+    for (int i = 0; i < TIMER_LEVELS; i++)
+        _occupied[i] = 0;
+}
+
+/*
+** create(unsigned int owner)
+** Allocates an unarmed timer reporting owner when it fires.
+**
+** Returns: id, valid until destroy()
+*/
+TimerId TimerWheel::create(unsigned int owner)
+{
+    TimerId id;
+
+    if (_free.empty())
+    {
+        id = _nodes.size();
+        _nodes.push_back(Node());
+    }
+    else
+    {
+        id = _free.back();
+        _free.pop_back();
+    }
+    _nodes[id].prev = -1;
+    _nodes[id].next = -1;
+    _nodes[id].slot = -1;
+    _nodes[id].owner = owner;
+    _nodes[id].expires = 0;
+    return (id);
+}
+
+void    TimerWheel::destroy(TimerId id)
+{
+    if (id == NO_TIMER)
+        return ;
+    cancel(id);
+    _free.push_back(id);
+}
+
+/*
+** arm(TimerId id, unsigned long deadlineMs)
+** (Re)arms id to fire at the first tick at or after deadlineMs; a
+** deadline already past fires on the next tick.
+*/
+void    TimerWheel::arm(TimerId id, unsigned long deadlineMs)
+{
+    cancel(id);
+    _nodes[id].expires = (deadlineMs + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+    if (_nodes[id].expires <= _current)
+        _nodes[id].expires = _current + 1;
+    link(id);
+    _armed++;
+}
+
+void    TimerWheel::cancel(TimerId id)
+{
+    if (id == NO_TIMER || _nodes[id].slot == -1)
+        return ;
+    unlink(id);
+    _armed--;
+}
+
+bool    TimerWheel::isArmed(TimerId id) const
+{
+    return (id != NO_TIMER && _nodes[id].slot != -1);
+}
+
+size_t  TimerWheel::size() const
+{
+    return (_armed);
+}
+
+/*
+** link(TimerId id) [PRIVATE]
+** Puts an armed timer in the lowest level whose span covers its delay,
+** at the slot its expiry tick maps to on that level. Delays beyond the
+** top level are parked in its last slot and re-placed on cascade.
+*/
+void    TimerWheel::link(TimerId id)
+{
+    Node&           node = _nodes[id];
+    unsigned long   delta = node.expires - _current;
+    unsigned long   expires = node.expires;
+    int             level = 0;
+
+    while (level < TIMER_LEVELS - 1 && delta >= (1UL << (TIMER_SLOT_BITS * (level + 1))))
+        level++;
+    if (delta >= (1UL << (TIMER_SLOT_BITS * TIMER_LEVELS)))
+        expires = _current + (1UL << (TIMER_SLOT_BITS * TIMER_LEVELS)) - 1;
+
+    unsigned int index = (expires >> (TIMER_SLOT_BITS * level)) & (TIMER_SLOTS - 1);
+    int slot = level * TIMER_SLOTS + index;
+
+    node.slot = slot;
+    node.prev = -1;
+    node.next = _heads[slot];
+    if (node.next != -1)
+        _nodes[node.next].prev = id;
+    _heads[slot] = id;
+    _occupied[level] |= 1u << index;
+}
+
+void    TimerWheel::unlink(TimerId id)
+{
+    Node&   node = _nodes[id];
+
+    if (node.prev != -1)
+        _nodes[node.prev].next = node.next;
+    else
+        _heads[node.slot] = node.next;
+    if (node.next != -1)
+        _nodes[node.next].prev = node.prev;
+    if (_heads[node.slot] == -1)
+        _occupied[node.slot / TIMER_SLOTS] &= ~(1u << (node.slot % TIMER_SLOTS));
+    node.slot = -1;
+}
+
+/*
+** cascade(int level, unsigned int index) [PRIVATE]
+** Re-places every timer of one slot now that the levels below have
+** come round to it; each lands on a lower level (or fires this tick).
+*/
+void    TimerWheel::cascade(int level, unsigned int index)
+{
+    int slot = level * TIMER_SLOTS + index;
+    int id = _heads[slot];
+
+    _heads[slot] = -1;
+    _occupied[level] &= ~(1u << index);
+    while (id != -1)
+    {
+        int next = _nodes[id].next;
+        link(id);
+        id = next;
+    }
+}
+
+/*
+** advance(unsigned long nowMs, std::vector<unsigned int>& expired)
+** Turns the wheel up to nowMs and appends the owner of every timer
+** that fired (they are disarmed, not destroyed). Ticks without work
+** (no occupied slot, no cascade of one) are skipped, so a long sleep
+** costs nothing.
+*/
+void    TimerWheel::advance(unsigned long nowMs, std::vector<unsigned int>& expired)
+{
+    unsigned long target = nowMs / TIMER_TICK_MS;
+
+    while (_armed > 0)
+    {
+        unsigned long next = nextTick();
+        if (next > target)
+            break ;
+        _current = next;
+
+        unsigned int index = _current & (TIMER_SLOTS - 1);
+        for (int level = 1; index == 0 && level < TIMER_LEVELS; level++)
+        {
+            index = (_current >> (TIMER_SLOT_BITS * level)) & (TIMER_SLOTS - 1);
+            cascade(level, index);
+        }
+
+        int slot = _current & (TIMER_SLOTS - 1);
+        while (_heads[slot] != -1)
+        {
+            TimerId id = _heads[slot];
+            unlink(id);
+            _armed--;
+            expired.push_back(_nodes[id].owner);
+        }
+    }
+    if (_current < target)
+        _current = target;
+}
+
+/*
+** nextSlotDistance(unsigned int mask, unsigned int index)
+** Distance (1 to TIMER_SLOTS) from index to the next occupied slot of
+** a level, the slot at index itself counting as a full turn away.
+*/
+static unsigned int nextSlotDistance(unsigned int mask, unsigned int index)
+{
+    unsigned int start = (index + 1) & (TIMER_SLOTS - 1);
+    unsigned int rotated = mask;
+
+    if (start != 0)
+        rotated = (mask >> start) | (mask << (TIMER_SLOTS - start));
+    return (__builtin_ctz(rotated) + 1);
+}
+
+/*
+** nextTick() [PRIVATE]
+** The next tick with work: the next occupied level 0 slot, or the next
+** cascade of an occupied higher slot, whichever is first.
+**
+** Returns: ULONG_MAX if no timer is armed
+*/
+unsigned long   TimerWheel::nextTick() const
+{
+    unsigned long next = ULONG_MAX;
+
+    if (_occupied[0] != 0)
+        next = _current + nextSlotDistance(_occupied[0], _current & (TIMER_SLOTS - 1));
+    for (int level = 1; level < TIMER_LEVELS; level++)
+    {
+        if (_occupied[level] == 0)
+            continue ;
+        unsigned long turn = _current >> (TIMER_SLOT_BITS * level);
+        unsigned long tick = (turn + nextSlotDistance(_occupied[level],
+            turn & (TIMER_SLOTS - 1))) << (TIMER_SLOT_BITS * level);
+        if (tick < next)
+            next = tick;
+    }
+    return (next);
+}
+
+/*
+** nextTimeout(unsigned long nowMs)
+** Milliseconds until the wheel next has work (see nextTick()), as a
+** poll()/epoll_wait() timeout.
+**
+** Returns: 0 if overdue, -1 if no timer is armed
+*/
+int TimerWheel::nextTimeout(unsigned long nowMs) const
+{
+    if (_armed == 0)
+        return (-1);
+
+    unsigned long due = nextTick() * TIMER_TICK_MS;
+    if (due <= nowMs)
+        return (0);
+    if (due - nowMs > INT_MAX)
+        return (INT_MAX);
+    return (due - nowMs);
+}
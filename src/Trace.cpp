@@ -0,0 +1,254 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Trace.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:12:05 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 21:12:05 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/Trace.hpp"
+#include "../inc/CommandEngine.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <new>
+#include <algorithm>
+#include <unistd.h>
+
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+#define TRACE_INSTANT_FLAG 0x10000UL
+
+static const char* const    g_eventNames[TRACE_EVENT_COUNT] =
+{
+    "dispatch", "read", "write", "command", "broadcast", "accept", "close"
+};
+
+static const char* const    g_argNames[TRACE_EVENT_COUNT][2] =
+{
+    { "lines", NULL },
+    { "bytes", NULL },
+    { "bytes", NULL },
+    { "command", "client" },
+    { "channel", "members" },
+    { "address", NULL },
+    { NULL, NULL }
+};
+
+static __thread TraceRing*  g_localRing = NULL;
+
+TraceRing*      TraceLog::_rings[TRACE_MAX_THREADS];
+unsigned int    TraceLog::_count = 0;
+
+TraceRing::TraceRing(const std::string& name) : _claimed(0), _head(0), _name(name)
+{
+    for (size_t i = 0; i < TRACE_RING_SIZE; i++)
+    {
+        _records[i].start = 0;
+        _records[i].duration = 0;
+        _records[i].meta = 0;
+        _records[i].arg0 = 0;
+        _records[i].arg1 = 0;
+    }
+}
+
+/*
+** push(const TraceRecord& record)
+** Owning thread only. Claims the next slot (the release fence orders the
+** claim before the overwrite), fills it, then publishes it.
+*/
+void    TraceRing::push(const TraceRecord& record)
+{
+    unsigned long   index = _head;
+    TraceRecord&    slot = _records[index & TRACE_RING_MASK];
+
+    __atomic_store_n(&_claimed, index + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&slot.start, record.start, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot.duration, record.duration, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot.meta, record.meta, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot.arg0, record.arg0, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot.arg1, record.arg1, __ATOMIC_RELAXED);
+    __atomic_store_n(&_head, index + 1, __ATOMIC_RELEASE);
+}
+
+/*
+** snapshot(std::vector<TraceRecord>& out) const
+** Any thread. Copies the published records, then drops those whose slot
+** the owner claimed again while they were being copied.
+*/
+void    TraceRing::snapshot(std::vector<TraceRecord>& out) const
+{
+    unsigned long   head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+    unsigned long   first = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+    std::vector<TraceRecord>    copy;
+
+    copy.reserve(head - first);
+    for (unsigned long i = first; i < head; i++)
+    {
+        const TraceRecord&  slot = _records[i & TRACE_RING_MASK];
+        TraceRecord         record;
+
+        record.start = __atomic_load_n(&slot.start, __ATOMIC_RELAXED);
+        record.duration = __atomic_load_n(&slot.duration, __ATOMIC_RELAXED);
+        record.meta = __atomic_load_n(&slot.meta, __ATOMIC_RELAXED);
+        record.arg0 = __atomic_load_n(&slot.arg0, __ATOMIC_RELAXED);
+        record.arg1 = __atomic_load_n(&slot.arg1, __ATOMIC_RELAXED);
+        copy.push_back(record);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    unsigned long   claimed = __atomic_load_n(&_claimed, __ATOMIC_RELAXED);
+    unsigned long   valid = claimed > TRACE_RING_SIZE ? claimed - TRACE_RING_SIZE : 0;
+    for (unsigned long i = std::max(first, valid); i < head; i++)
+        out.push_back(copy[i - first]);
+}
+
+const std::string&  TraceRing::getName() const
+{
+    return (_name);
+}
+
+/*
+** create(const std::string& name) [PRIVATE, STATIC]
+** Registers a ring for the calling thread.
+**
+** Returns: the ring, NULL once TRACE_MAX_THREADS threads have one (or
+**          without memory); that thread then records nothing
+*/
+TraceRing*  TraceLog::create(const std::string& name)
+{
+    unsigned int    index = __atomic_fetch_add(&_count, 1, __ATOMIC_RELAXED);
+
+    if (index >= TRACE_MAX_THREADS)
+        return (NULL);
+    TraceRing*  ring = new (std::nothrow) TraceRing(name);
+    __atomic_store_n(&_rings[index], ring, __ATOMIC_RELEASE);
+    return (ring);
+}
+
+/*
+** registerThread(const char* name, unsigned int id) [STATIC]
+** Names the calling thread's ring "<name> <id>" in the dump; a thread
+** that records without registering shows up as "thread 0".
+*/
+void    TraceLog::registerThread(const char* name, unsigned int id)
+{
+    std::ostringstream  label;
+
+    if (g_localRing)
+        return ;
+    label << name << " " << id;
+    g_localRing = create(label.str());
+}
+
+/*
+** append(...)
+** Pushes a record to the calling thread's ring, registering one first.
+*/
+static void append(unsigned long meta, unsigned long start, unsigned long duration,
+                unsigned long arg0, unsigned long arg1)
+{
+    if (!g_localRing)
+        TraceLog::registerThread("thread", 0);
+    if (!g_localRing)
+        return ;
+
+    TraceRecord record;
+
+    record.start = start;
+    record.duration = duration;
+    record.meta = meta;
+    record.arg0 = arg0;
+    record.arg1 = arg1;
+    g_localRing->push(record);
+}
+
+static unsigned long    packMeta(TraceEventId event, int fd)
+{
+    return (((unsigned long)(unsigned int)fd << 32) | (unsigned long)event);
+}
+
+void    TraceLog::record(TraceEventId event, int fd, unsigned long start,
+            unsigned long duration, unsigned long arg0, unsigned long arg1)
+{
+    append(packMeta(event, fd), start, duration, arg0, arg1);
+}
+
+void    TraceLog::instant(TraceEventId event, int fd, unsigned long arg0, unsigned long arg1)
+{
+    append(packMeta(event, fd) | TRACE_INSTANT_FLAG, Metrics::clock(), 0, arg0, arg1);
+}
+
+static void writeEvent(std::ofstream& out, const TraceRecord& record, pid_t pid,
+                unsigned int tid)
+{
+    size_t      event = record.meta & 0xffff;
+    int         fd = (int)(unsigned int)(record.meta >> 32);
+    bool        instant = (record.meta & TRACE_INSTANT_FLAG) != 0;
+
+    if (event >= TRACE_EVENT_COUNT)
+        return ;
+    out << ",\n{\"name\":\"";
+    if (event == TRACE_COMMAND)
+        out << CommandEngine::name((CommandId)record.arg0);
+    else
+        out << g_eventNames[event];
+    out << "\",\"cat\":\"" << g_eventNames[event] << "\",\"ph\":\"" << (instant ? "i" : "X")
+        << "\",\"pid\":" << pid << ",\"tid\":" << tid
+        << ",\"ts\":" << record.start / 1000 << "." << std::setw(3) << std::setfill('0')
+        << record.start % 1000;
+    if (instant)
+        out << ",\"s\":\"t\"";
+    else
+        out << ",\"dur\":" << record.duration / 1000 << "." << std::setw(3)
+            << std::setfill('0') << record.duration % 1000;
+    out << ",\"args\":{\"fd\":" << fd;
+    if (g_argNames[event][0])
+        out << ",\"" << g_argNames[event][0] << "\":" << record.arg0;
+    if (g_argNames[event][1])
+        out << ",\"" << g_argNames[event][1] << "\":" << record.arg1;
+    out << "}}";
+}
+
+/*
+** dump(const std::string& path) [STATIC]
+** Writes a snapshot of every ring as a Chrome trace (JSON object format,
+** timestamps in µs): one "X" event per span, one "i" per instant, and a
+** thread_name entry per ring. Safe while the other threads keep tracing.
+**
+** Returns: false if the file could not be written
+*/
+bool    TraceLog::dump(const std::string& path)
+{
+    std::ofstream   out(path.c_str());
+    pid_t           pid = getpid();
+
+    if (!out)
+        return (false);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+        << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"name\":\"ircserv\"}}";
+
+    unsigned int    count = std::min(__atomic_load_n(&_count, __ATOMIC_RELAXED),
+                        (unsigned int)TRACE_MAX_THREADS);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        TraceRing*  ring = __atomic_load_n(&_rings[i], __ATOMIC_ACQUIRE);
+        std::vector<TraceRecord>    records;
+
+        if (!ring)
+            continue ;
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << i + 1
+            << ",\"args\":{\"name\":\"" << ring->getName() << "\"}}";
+        ring->snapshot(records);
+        for (size_t j = 0; j < records.size(); j++)
+            writeEvent(out, records[j], pid, i + 1);
+    }
+    out << "\n]}\n";
+    out.close();
+    return (!out.fail());
+}
@@ -0,0 +1,226 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UserRegistry.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:09:40 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 14:09:40 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../inc/UserRegistry.hpp"
+#include "../inc/CaseMapping.hpp"
+
+UserRegistry::UserRegistry() : _nickCount(0), _registeredCount(0)
+{
+    NickSlot    empty = { 0, NULL };
+
+    _nickSlots.assign(NICK_TABLE_MIN_CAPACITY, empty);
+}
+
+UserRegistry::~UserRegistry() {}
+
+/*
+** createClient(int fd)
+** New client for the connection on fd, owned by the registry.
+**
+** Returns: the client, NULL if the pool is exhausted
+*/
+Client* UserRegistry::createClient(int fd)
+{
+    return (_clients.get(_clients.create(fd)));
+}
+
+/*
+** removeClient(ClientHandle handle)
+** Forgets the client and its nickname, and frees it. Every handle to it
+** goes stale. A stale handle is ignored.
+*/
+void    UserRegistry::removeClient(ClientHandle handle)
+{
+    Client* client = _clients.get(handle);
+    if (client == NULL)
+        return ;
+
+    eraseNick(client);
+    if (client->getState() == REGISTERED)
+        _registeredCount--;
+    _clients.destroy(handle);
+}
+
+/*
+** getClient(ClientHandle handle)
+** Returns: the client, NULL if it is gone
+*/
+Client* UserRegistry::getClient(ClientHandle handle)
+{
+    return (_clients.get(handle));
+}
+
+/*
+** findSlot(Atom folded) [PRIVATE]
+** Linear probe from the name's home slot. Names are compared as atoms.
+**
+** Returns: index of the slot holding the name, or of the free slot
+**          that ends its probe sequence (the table is never full)
+*/
+size_t  UserRegistry::findSlot(Atom folded) const
+{
+    const AtomTable&    atoms = AtomTable::instance();
+    unsigned int        hash = atoms.hash(folded);
+    size_t              mask = _nickSlots.size() - 1;
+    size_t              i = hash & mask;
+
+    while (_nickSlots[i].client != NULL)
+    {
+        if (_nickSlots[i].hash == hash
+            && atoms.folded(_nickSlots[i].client->getNicknameAtom()) == folded)
+            break ;
+        i = (i + 1) & mask;
+    }
+    return (i);
+}
+
+/*
+** getClientByNick(const std::string& nick)
+** Folds nick on the stack; a name nobody interned cannot be a nickname.
+*/
+Client* UserRegistry::getClientByNick(const std::string& nick)
+{
+    char    folded[NICKLEN];
+
+    if (nick.empty() || nick.length() > NICKLEN)
+        return (NULL);
+    CaseMapping::fold(nick.data(), nick.length(), folded);
+
+    Atom    atom = AtomTable::instance().find(folded, nick.length());
+    if (atom == NO_ATOM)
+        return (NULL);
+    return (_nickSlots[findSlot(atom)].client);
+}
+
+bool    UserRegistry::isNickAvailable(const std::string& nick)
+{
+    return (getClientByNick(nick) == NULL);
+}
+
+/*
+** insertNick(Client* client) [PRIVATE]
+** Indexes the client under its current nickname.
+*/
+void    UserRegistry::insertNick(Client* client)
+{
+    const AtomTable&    atoms = AtomTable::instance();
+    Atom                nick = client->getNicknameAtom();
+
+    if (nick == NO_ATOM || atoms.text(nick).length() > NICKLEN)
+        return ;
+    if ((_nickCount + 1) * 2 > _nickSlots.size())
+        growNickTable();
+
+    Atom        folded = atoms.folded(nick);
+    NickSlot    slot = { atoms.hash(folded), client };
+    size_t      i = findSlot(folded);
+    if (_nickSlots[i].client == NULL)
+        _nickCount++;
+    _nickSlots[i] = slot;
+}
+
+/*
+** eraseNick(Client* client) [PRIVATE]
+** Frees the slot of the client's current nickname, then walks the rest
+** of its cluster and moves back every entry whose home slot is not
+** between the hole and its current position, so probe sequences stay
+** unbroken.
+*/
+void    UserRegistry::eraseNick(Client* client)
+{
+    if (client->getNicknameAtom() == NO_ATOM)
+        return ;
+
+    size_t  mask = _nickSlots.size() - 1;
+    size_t  hole = findSlot(AtomTable::instance().folded(client->getNicknameAtom()));
+    if (_nickSlots[hole].client != client)
+        return ;
+
+    for (size_t j = (hole + 1) & mask; _nickSlots[j].client != NULL; j = (j + 1) & mask)
+    {
+        size_t  home = _nickSlots[j].hash & mask;
+        bool    stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+        if (stays)
+            continue ;
+        _nickSlots[hole] = _nickSlots[j];
+        hole = j;
+    }
+    _nickSlots[hole].client = NULL;
+    _nickCount--;
+}
+
+/*
+** growNickTable() [PRIVATE]
+** Doubles the table and re-inserts every entry (hashes are cached).
+*/
+void    UserRegistry::growNickTable()
+{
+    std::vector<NickSlot>   old;
+    NickSlot                empty = { 0, NULL };
+
+    old.swap(_nickSlots);
+    _nickSlots.assign(old.size() * 2, empty);
+
+    size_t  mask = _nickSlots.size() - 1;
+    for (size_t i = 0; i < old.size(); i++)
+    {
+        if (old[i].client == NULL)
+            continue ;
+        size_t  j = old[i].hash & mask;
+        while (_nickSlots[j].client != NULL)
+            j = (j + 1) & mask;
+        _nickSlots[j] = old[i];
+    }
+}
+
+/*
+** updateNickname(Client* client, const std::string& newNick)
+** Re-keys the client under newNick and renames it; the Client object
+** itself stays where it is. The caller checked the nick is free (or
+** only differs from the current one in case).
+*/
+void    UserRegistry::updateNickname(Client* client, const std::string& newNick)
+{
+    eraseNick(client);
+    client->setNickname(newNick);
+    insertNick(client);
+}
+
+/*
+** markRegistered(Client* client)
+** Promotes the client to REGISTERED and counts it as a user.
+*/
+void    UserRegistry::markRegistered(Client* client)
+{
+    if (client->getState() == REGISTERED)
+        return ;
+    client->setState(REGISTERED);
+    _registeredCount++;
+}
+
+/*
+** getClientCount()
+** Returns: every client, registered or not
+*/
+size_t  UserRegistry::getClientCount() const
+{
+    return (_clients.size());
+}
+
+/*
+** getRegisteredCount()
+** Returns: the clients that completed registration (LUSERS 251)
+*/
+size_t  UserRegistry::getRegisteredCount() const
+{
+    return (_registeredCount);
+}
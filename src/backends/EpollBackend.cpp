@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EpollBackend.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:11:47 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 10:11:47 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/backends/EpollBackend.hpp"
+
+#ifdef __linux__
+
+# include <stdexcept>
+# include <unistd.h>
+
+# define EPOLL_INITIAL_EVENTS 64
+
+EpollBackend::EpollBackend() : _readyEvents(EPOLL_INITIAL_EVENTS)
+{
+    _epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epollFd == -1)
+        throw std::runtime_error("Error: epoll_create1 failed");
+}
+
+EpollBackend::~EpollBackend()
+{
+    if (_epollFd != -1)
+        close(_epollFd);
+}
+
+/*
+** addFd(int fd)
+** Registers fd edge-triggered for input and peer half-close.
+** EPOLLRDHUP is reported as a read so pending bytes are drained before
+** recv() returns 0 and the client is dropped.
+*/
+void    EpollBackend::addFd(int fd)
+{
+    struct epoll_event ev;
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    ev.data.fd = fd;
+    if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &ev) == -1)
+        throw std::runtime_error("Error: epoll_ctl ADD failed");
+}
+
+void    EpollBackend::removeFd(int fd)
+{
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, NULL);
+}
+
+/*
+** setWriteInterest(int fd, bool enabled)
+** Adds/removes EPOLLOUT. EPOLL_CTL_MOD re-arms the edge, so a socket
+** that is already writable is reported on the next wait().
+*/
+void    EpollBackend::setWriteInterest(int fd, bool enabled)
+{
+    struct epoll_event ev;
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    if (enabled)
+        ev.events |= EPOLLOUT;
+    ev.data.fd = fd;
+    epoll_ctl(_epollFd, EPOLL_CTL_MOD, fd, &ev);
+}
+
+/*
+** wait(std::vector<IOEvent>& events, int timeoutMs)
+** epoll_wait() into a reusable array; the array doubles when a wait
+** fills it completely so bursts are not spread over extra iterations.
+**
+** Returns: number of ready fds, -1 on error (errno preserved)
+*/
+int EpollBackend::wait(std::vector<IOEvent>& events, int timeoutMs)
+{
+    events.clear();
+
+    int ready = epoll_wait(_epollFd, &_readyEvents[0], _readyEvents.size(), timeoutMs);
+    if (ready <= 0)
+        return (ready);
+
+    for (int i = 0; i < ready; i++)
+    {
+        unsigned int flags = _readyEvents[i].events;
+
+        IOEvent event;
+        event.fd = _readyEvents[i].data.fd;
+        event.flags = 0;
+        if (flags & (EPOLLIN | EPOLLRDHUP))
+            event.flags |= EVENT_READ;
+        if (flags & EPOLLOUT)
+            event.flags |= EVENT_WRITE;
+        if (flags & (EPOLLHUP | EPOLLERR))
+            event.flags |= EVENT_ERROR;
+        events.push_back(event);
+    }
+    if (ready == (int)_readyEvents.size())
+        _readyEvents.resize(_readyEvents.size() * 2);
+    return (ready);
+}
+
+const char* EpollBackend::getName() const
+{
+    return ("epoll");
+}
+
+#endif
@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PollBackend.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 10:06:12 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 10:06:12 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/backends/PollBackend.hpp"
+#include <stdexcept>
+
+PollBackend::PollBackend() {}
+
+PollBackend::~PollBackend() {}
+
+/*
+** addFd(int fd)
+** Appends a pollfd slot watching POLLIN and records its index.
+*/
+void    PollBackend::addFd(int fd)
+{
+    if (fd >= (int)_slotByFd.size())
+        _slotByFd.resize(fd + 1, -1);
+
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    _slotByFd[fd] = _pollFds.size();
+    _pollFds.push_back(pfd);
+}
+
+/*
+** removeFd(int fd)
+** Swap-removes the fd's slot: the last pollfd moves into the hole and
+** its index entry is patched, so no middle-of-vector erase is needed.
+*/
+void    PollBackend::removeFd(int fd)
+{
+    if (fd < 0 || fd >= (int)_slotByFd.size() || _slotByFd[fd] == -1)
+        return ;
+
+    int slot = _slotByFd[fd];
+    int last = _pollFds.size() - 1;
+    if (slot != last)
+    {
+        _pollFds[slot] = _pollFds[last];
+        _slotByFd[_pollFds[slot].fd] = slot;
+    }
+    _pollFds.pop_back();
+    _slotByFd[fd] = -1;
+}
+
+void    PollBackend::setWriteInterest(int fd, bool enabled)
+{
+    if (fd < 0 || fd >= (int)_slotByFd.size() || _slotByFd[fd] == -1)
+        return ;
+    if (enabled)
+        _pollFds[_slotByFd[fd]].events |= POLLOUT;
+    else
+        _pollFds[_slotByFd[fd]].events &= ~POLLOUT;
+}
+
+/*
+** setReadInterest(int fd, bool enabled)
+** Drops POLLIN while the connection's receive ring is full: poll() is
+** level-triggered and would otherwise report the unread data on every
+** call. Hangups and errors are still reported.
+*/
+void    PollBackend::setReadInterest(int fd, bool enabled)
+{
+    if (fd < 0 || fd >= (int)_slotByFd.size() || _slotByFd[fd] == -1)
+        return ;
+    if (enabled)
+        _pollFds[_slotByFd[fd]].events |= POLLIN;
+    else
+        _pollFds[_slotByFd[fd]].events &= ~POLLIN;
+}
+
+/*
+** wait(std::vector<IOEvent>& events, int timeoutMs)
+** poll() over every slot, then collects the ones with revents set.
+** This is the O(connections) path kept for non-Linux systems.
+**
+** Returns: number of ready fds, -1 on error (errno preserved)
+*/
+int PollBackend::wait(std::vector<IOEvent>& events, int timeoutMs)
+{
+    events.clear();
+    if (_pollFds.empty())
+        return (0);
+
+    int ready = poll(&_pollFds[0], _pollFds.size(), timeoutMs);
+    if (ready <= 0)
+        return (ready);
+
+    for (size_t i = 0; i < _pollFds.size() && (int)events.size() < ready; i++)
+    {
+        short revents = _pollFds[i].revents;
+        if (revents == 0)
+            continue ;
+
+        IOEvent event;
+        event.fd = _pollFds[i].fd;
+        event.flags = 0;
+        if (revents & POLLIN)
+            event.flags |= EVENT_READ;
+        if (revents & POLLOUT)
+            event.flags |= EVENT_WRITE;
+        if (revents & (POLLHUP | POLLERR | POLLNVAL))
+            event.flags |= EVENT_ERROR;
+        events.push_back(event);
+    }
+    return (events.size());
+}
+
+const char* PollBackend::getName() const
+{
+    return ("poll");
+}
@@ -0,0 +1,662 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UringBackend.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 19:05:12 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 19:05:12 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/backends/UringBackend.hpp"
+
+#ifdef __linux__
+
+# include <stdexcept>
+# include <cstring>
+# include <algorithm>
+# include <errno.h>
+# include <poll.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+
+/*
+** user_data layout: op (8 bits) | armSeq (8) | generation (16) | fd (32)
+** Sends carry the SendOp index instead of fd/generation/armSeq.
+*/
+enum UringOp
+{
+    URING_OP_POLL = 1,
+    URING_OP_ACCEPT,
+    URING_OP_RECV,
+    URING_OP_SEND,
+    URING_OP_CANCEL,
+    URING_OP_BACKOFF
+};
+
+static __u64    makeTag(int op, int fd, unsigned short generation, unsigned char seq)
+{
+    return (((__u64)op << 56) | ((__u64)seq << 48) | ((__u64)generation << 32)
+        | (unsigned int)fd);
+}
+
+UringBackend::FdState::FdState()
+    : generation(0), armSeq(0), role(FD_UNUSED), armed(false), paused(false), sendOp(-1) {}
+
+/*
+** UringBackend()
+** Sets up the rings and registers the provided buffers.
+**
+** Throws: std::runtime_error when io_uring is unusable here (old
+**         kernel, io_uring_disabled sysctl, seccomp...); create() then
+**         falls back to epoll
+*/
+UringBackend::UringBackend()
+    : _ringFd(-1), _sqRing(MAP_FAILED), _sqRingSize(0), _cqRing(MAP_FAILED), _cqRingSize(0),
+    _sqes(static_cast<struct io_uring_sqe*>(MAP_FAILED)), _sqesSize(0), _sqHead(NULL),
+    _sqTail(NULL), _sqMask(0), _sqEntries(0), _sqLocalTail(0), _cqHead(NULL), _cqTail(NULL),
+    _cqMask(0), _cqes(NULL), _bufRing(static_cast<struct io_uring_buf_ring*>(MAP_FAILED)),
+    _buffers(static_cast<char*>(MAP_FAILED)), _bufTail(0)
+{
+    _acceptBackoff.tv_sec = 0;
+    _acceptBackoff.tv_nsec = URING_ACCEPT_BACKOFF_MS * 1000000L;
+    try
+    {
+        setupRing();
+        setupBuffers();
+    }
+    catch (std::runtime_error&)
+    {
+        teardown();
+        throw ;
+    }
+}
+
+UringBackend::~UringBackend()
+{
+    teardown();
+}
+
+/*
+** teardown() [PRIVATE]
+** Closing the ring cancels whatever is still in flight, so the pinned
+** send buffers can be released right after.
+*/
+void    UringBackend::teardown()
+{
+    if (_ringFd != -1)
+        close(_ringFd);
+    _ringFd = -1;
+    if (_sqRing != MAP_FAILED)
+        munmap(_sqRing, _sqRingSize);
+    if (_cqRing != MAP_FAILED)
+        munmap(_cqRing, _cqRingSize);
+    if (_sqes != MAP_FAILED)
+        munmap(_sqes, _sqesSize);
+    if (_bufRing != MAP_FAILED)
+        munmap(_bufRing, URING_BUFFER_COUNT * sizeof(struct io_uring_buf));
+    if (_buffers != MAP_FAILED)
+        munmap(_buffers, URING_BUFFER_COUNT * URING_BUFFER_SIZE);
+    _sqRing = _cqRing = MAP_FAILED;
+    _sqes = static_cast<struct io_uring_sqe*>(MAP_FAILED);
+    _bufRing = static_cast<struct io_uring_buf_ring*>(MAP_FAILED);
+    _buffers = static_cast<char*>(MAP_FAILED);
+    for (size_t i = 0; i < _sendOps.size(); i++)
+        delete _sendOps[i];
+    _sendOps.clear();
+    _freeSendOps.clear();
+}
+
+/*
+** setupRing() [PRIVATE]
+** io_uring_setup() with a large completion queue (one multishot recv
+** can post many completions per wait), then maps the three regions.
+** COOP_TASKRUN skips the interrupt-style wakeups when completions are
+** only consumed on the next enter anyway; it is dropped on kernels
+** that reject it.
+** Multishot recv (6.0) cannot be probed directly, IORING_OP_SEND_ZC
+** arrived in the same release and stands in for it.
+*/
+void    UringBackend::setupRing()
+{
+    struct io_uring_params  params;
+
+    std::memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+    params.cq_entries = URING_CQ_ENTRIES;
+    _ringFd = syscall(__NR_io_uring_setup, URING_SQ_ENTRIES, &params);
+    if (_ringFd == -1 && errno == EINVAL)
+    {
+        std::memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = URING_CQ_ENTRIES;
+        _ringFd = syscall(__NR_io_uring_setup, URING_SQ_ENTRIES, &params);
+    }
+    if (_ringFd == -1)
+        throw std::runtime_error("Error: io_uring_setup failed");
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP)
+            || !probeOpcode(IORING_OP_SEND_ZC))
+        throw std::runtime_error("Error: io_uring lacks multishot recv");
+
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    _sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    _sqRing = mmap(NULL, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        _ringFd, IORING_OFF_SQ_RING);
+    _cqRing = mmap(NULL, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        _ringFd, IORING_OFF_CQ_RING);
+    _sqes = static_cast<struct io_uring_sqe*>(mmap(NULL, _sqesSize, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQES));
+    if (_sqRing == MAP_FAILED || _cqRing == MAP_FAILED || _sqes == MAP_FAILED)
+        throw std::runtime_error("Error: io_uring mmap failed");
+
+    char*   sq = static_cast<char*>(_sqRing);
+    char*   cq = static_cast<char*>(_cqRing);
+    _sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    _sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    _sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    _sqEntries = params.sq_entries;
+    _sqLocalTail = *_sqTail;
+    unsigned* array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    for (unsigned i = 0; i < _sqEntries; i++)
+        array[i] = i;
+    _cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    _cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+}
+
+/*
+** probeOpcode(int opcode) [PRIVATE]
+** Returns: true if the running kernel supports opcode
+*/
+bool    UringBackend::probeOpcode(int opcode)
+{
+    size_t  size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    std::vector<char>   storage(size, 0);
+    struct io_uring_probe*  probe = reinterpret_cast<struct io_uring_probe*>(&storage[0]);
+
+    if (syscall(__NR_io_uring_register, _ringFd, IORING_REGISTER_PROBE, probe, 256) == -1)
+        return (false);
+    if (opcode > probe->last_op)
+        return (false);
+    return (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED);
+}
+
+/*
+** setupBuffers() [PRIVATE]
+** Registers a ring of URING_BUFFER_COUNT provided buffers (5.19+):
+** recv completions pick one each, the kernel never waits on a buffer
+** per socket. Idle connections therefore cost no receive memory.
+*/
+void    UringBackend::setupBuffers()
+{
+    size_t  ringSize = URING_BUFFER_COUNT * sizeof(struct io_uring_buf);
+
+    _bufRing = static_cast<struct io_uring_buf_ring*>(mmap(NULL, ringSize,
+        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    _buffers = static_cast<char*>(mmap(NULL, URING_BUFFER_COUNT * URING_BUFFER_SIZE,
+        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (_bufRing == MAP_FAILED || _buffers == MAP_FAILED)
+        throw std::runtime_error("Error: io_uring buffer allocation failed");
+
+    struct io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<unsigned long>(_bufRing);
+    reg.ring_entries = URING_BUFFER_COUNT;
+    reg.bgid = URING_BUFFER_GROUP;
+    if (syscall(__NR_io_uring_register, _ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) == -1)
+        throw std::runtime_error("Error: io_uring buffer ring registration failed");
+
+    for (int bid = 0; bid < URING_BUFFER_COUNT; bid++)
+        recycleBuffer(bid);
+    __atomic_store_n(&_bufRing->tail, _bufTail, __ATOMIC_RELEASE);
+}
+
+/*
+** recycleBuffer(int bid) [PRIVATE]
+** Hands buffer bid back to the kernel. The ring tail is published once
+** per wait(), not per buffer.
+*/
+void    UringBackend::recycleBuffer(int bid)
+{
+    // not _bufRing->bufs: C++ gives the header's flex-array wrapper a
+    // non-zero size, the entries start at the ring itself
+    struct io_uring_buf* buf = reinterpret_cast<struct io_uring_buf*>(_bufRing)
+        + (_bufTail & (URING_BUFFER_COUNT - 1));
+
+    buf->addr = reinterpret_cast<unsigned long>(_buffers + (size_t)bid * URING_BUFFER_SIZE);
+    buf->len = URING_BUFFER_SIZE;
+    buf->bid = bid;
+    _bufTail++;
+}
+
+UringBackend::FdState*  UringBackend::state(int fd)
+{
+    if (fd < 0 || (size_t)fd >= _fds.size() || _fds[fd].role == FD_UNUSED)
+        return (NULL);
+    return (&_fds[fd]);
+}
+
+UringBackend::FdState&  UringBackend::track(int fd, FdRole role)
+{
+    if (fd < 0)
+        throw std::runtime_error("Error: io_uring invalid fd");
+    if ((size_t)fd >= _fds.size())
+        _fds.resize(fd + 1);
+    _fds[fd].role = role;
+    _fds[fd].armed = false;
+    _fds[fd].paused = false;
+    _fds[fd].sendOp = -1;
+    return (_fds[fd]);
+}
+
+/*
+** nextSqe() [PRIVATE]
+** Next free submission entry, zeroed. A full queue is submitted early
+** (rare: URING_SQ_ENTRIES requests queued in a single loop iteration).
+*/
+struct io_uring_sqe*    UringBackend::nextSqe()
+{
+    while (_sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries)
+    {
+        if (enter(0, 0) == -1 && errno != EINTR && errno != EBUSY && errno != EAGAIN)
+            throw std::runtime_error("Error: io_uring submission failed");
+    }
+
+    struct io_uring_sqe* sqe = &_sqes[_sqLocalTail & _sqMask];
+    std::memset(sqe, 0, sizeof(*sqe));
+    _sqLocalTail++;
+    return (sqe);
+}
+
+/*
+** enter(unsigned minComplete, int timeoutMs) [PRIVATE]
+** Publishes the queued submissions and, if minComplete, waits up to
+** timeoutMs (-1: forever) for a completion, all in one syscall.
+**
+** Returns: io_uring_enter() result (ETIME when the wait timed out)
+*/
+int UringBackend::enter(unsigned minComplete, int timeoutMs)
+{
+    struct io_uring_getevents_arg   arg;
+    struct __kernel_timespec        ts;
+    unsigned    flags = IORING_ENTER_GETEVENTS;
+    void*       argp = NULL;
+    size_t      argSize = 0;
+
+    __atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+    unsigned toSubmit = _sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+    if (minComplete > 0 && timeoutMs >= 0)
+    {
+        std::memset(&arg, 0, sizeof(arg));
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = (timeoutMs % 1000) * 1000000L;
+        arg.ts = reinterpret_cast<unsigned long>(&ts);
+        flags |= IORING_ENTER_EXT_ARG;
+        argp = &arg;
+        argSize = sizeof(arg);
+    }
+    return (syscall(__NR_io_uring_enter, _ringFd, toSubmit, minComplete, flags, argp, argSize));
+}
+
+void    UringBackend::armAccept(int fd, const FdState& st)
+{
+    struct io_uring_sqe* sqe = nextSqe();
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = makeTag(URING_OP_ACCEPT, fd, st.generation, st.armSeq);
+}
+
+void    UringBackend::armRecv(int fd, FdState& st)
+{
+    struct io_uring_sqe* sqe = nextSqe();
+
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_BUFFER_GROUP;
+    sqe->user_data = makeTag(URING_OP_RECV, fd, st.generation, st.armSeq);
+    st.armed = true;
+}
+
+void    UringBackend::armPoll(int fd, const FdState& st)
+{
+    struct io_uring_sqe* sqe = nextSqe();
+
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = POLLIN;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->user_data = makeTag(URING_OP_POLL, fd, st.generation, st.armSeq);
+}
+
+/*
+** armBackoff(int fd, const FdState& st) [PRIVATE]
+** A failing multishot accept (EMFILE...) is re-armed after a pause
+** instead of right away, which would spin on the same error.
+*/
+void    UringBackend::armBackoff(int fd, const FdState& st)
+{
+    struct io_uring_sqe* sqe = nextSqe();
+
+    sqe->opcode = IORING_OP_TIMEOUT;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<unsigned long>(&_acceptBackoff);
+    sqe->len = 1;
+    sqe->user_data = makeTag(URING_OP_BACKOFF, fd, st.generation, st.armSeq);
+}
+
+/*
+** cancel(__u64 userData) [PRIVATE]
+** Cancels by user_data rather than by fd: the fd is usually closed
+** before the cancel reaches the kernel.
+*/
+void    UringBackend::cancel(__u64 userData)
+{
+    struct io_uring_sqe* sqe = nextSqe();
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = userData;
+    sqe->user_data = makeTag(URING_OP_CANCEL, 0, 0, 0);
+}
+
+void    UringBackend::addFd(int fd)
+{
+    armPoll(fd, track(fd, FD_WATCHED));
+}
+
+void    UringBackend::addListener(int fd)
+{
+    armAccept(fd, track(fd, FD_LISTENER));
+}
+
+void    UringBackend::addConnection(int fd)
+{
+    armRecv(fd, track(fd, FD_CONNECTION));
+}
+
+/*
+** removeFd(int fd)
+** Cancels the fd's multishot request (a no-op if it already ended) and
+** in-flight send, then bumps its generation: anything still completing
+** for it is dropped, even once the fd number belongs to a new
+** connection.
+*/
+void    UringBackend::removeFd(int fd)
+{
+    FdState* st = state(fd);
+    if (st == NULL)
+        return ;
+
+    int op = URING_OP_POLL;
+    if (st->role == FD_LISTENER)
+        op = URING_OP_ACCEPT;
+    else if (st->role == FD_CONNECTION)
+        op = URING_OP_RECV;
+    cancel(makeTag(op, fd, st->generation, st->armSeq));
+    if (st->sendOp != -1)
+        cancel(makeTag(URING_OP_SEND, 0, 0, 0) | (unsigned int)st->sendOp);
+    st->generation++;
+    st->role = FD_UNUSED;
+    st->armed = false;
+    st->sendOp = -1;
+}
+
+void    UringBackend::setWriteInterest(int fd, bool enabled)
+{
+    (void)fd;
+    (void)enabled;
+}
+
+/*
+** setReadInterest(int fd, bool enabled)
+** Pauses/resumes a connection's multishot recv (its receive ring is
+** full). Completions already posted before the cancel still arrive;
+** the armSeq bump only keeps the cancelled request's final completion
+** from re-arming it.
+*/
+void    UringBackend::setReadInterest(int fd, bool enabled)
+{
+    FdState* st = state(fd);
+    if (st == NULL || st->role != FD_CONNECTION || st->paused == !enabled)
+        return ;
+
+    st->paused = !enabled;
+    if (!enabled && st->armed)
+    {
+        cancel(makeTag(URING_OP_RECV, fd, st->generation, st->armSeq));
+        st->armed = false;
+        st->armSeq++;
+    }
+    else if (enabled && !st->armed)
+        armRecv(fd, *st);
+}
+
+void    UringBackend::releaseBuffer(const IOEvent& event)
+{
+    if (event.flags & EVENT_DATA)
+        recycleBuffer(event.buffer);
+}
+
+/*
+** submitSend(int fd, const SharedBuffer* parts, size_t count, size_t offset)
+** Queues one sendmsg of parts (the first one starting at offset), up
+** to URING_SEND_BATCH of them. The buffers are pinned by reference
+** until the completion, which reports the bytes sent as EVENT_SENT.
+**
+** Returns: false if fd already has a send in flight
+*/
+bool    UringBackend::submitSend(int fd, const SharedBuffer* parts, size_t count, size_t offset)
+{
+    FdState* st = state(fd);
+    if (st == NULL || st->role != FD_CONNECTION || st->sendOp != -1 || count == 0)
+        return (false);
+
+    int index;
+    if (_freeSendOps.empty())
+    {
+        index = _sendOps.size();
+        _sendOps.push_back(new SendOp());
+    }
+    else
+    {
+        index = _freeSendOps.back();
+        _freeSendOps.pop_back();
+    }
+
+    SendOp* op = _sendOps[index];
+    op->fd = fd;
+    op->generation = st->generation;
+    op->pinned = std::min(count, (size_t)URING_SEND_BATCH);
+    for (size_t i = 0; i < op->pinned; i++)
+    {
+        size_t skip = (i == 0) ? offset : 0;
+        op->pins[i] = parts[i];
+        op->iov[i].iov_base = const_cast<char*>(parts[i].data()) + skip;
+        op->iov[i].iov_len = parts[i].length() - skip;
+    }
+    std::memset(&op->msg, 0, sizeof(op->msg));
+    op->msg.msg_iov = op->iov;
+    op->msg.msg_iovlen = op->pinned;
+
+    struct io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<unsigned long>(&op->msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = makeTag(URING_OP_SEND, 0, 0, 0) | (unsigned int)index;
+    st->sendOp = index;
+    return (true);
+}
+
+/*
+** wait(std::vector<IOEvent>& events, int timeoutMs)
+** Recycles the buffers released since the last call, submits and waits
+** in a single io_uring_enter(), then turns the completions into events
+** in the order the kernel posted them.
+**
+** Returns: number of events, -1 on error (errno preserved)
+*/
+int UringBackend::wait(std::vector<IOEvent>& events, int timeoutMs)
+{
+    events.clear();
+    __atomic_store_n(&_bufRing->tail, _bufTail, __ATOMIC_RELEASE);
+
+    unsigned head = *_cqHead;
+    bool ready = (head != __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE));
+    if (enter((ready || timeoutMs == 0) ? 0 : 1, timeoutMs) == -1
+            && errno != ETIME && errno != EBUSY && errno != EAGAIN)
+        return (-1);
+
+    unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++)
+    {
+        const struct io_uring_cqe& cqe = _cqes[head & _cqMask];
+
+        if ((cqe.user_data >> 56) == URING_OP_SEND)
+            completeSend(cqe, events);
+        else
+            completeFd(cqe, events);
+    }
+    __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+    return (events.size());
+}
+
+/*
+** completeFd(const struct io_uring_cqe& cqe, std::vector<IOEvent>& events) [PRIVATE]
+** Accept, recv, poll and backoff completions. A multishot request
+** that ended (no IORING_CQE_F_MORE) is re-armed, except:
+** - recv: EOF and errors become EVENT_ERROR, a paused or cancelled
+**   (older armSeq) request stays down; ENOBUFS (every buffer in use)
+**   re-arms once wait() has recycled some
+** - accept: errors re-arm after URING_ACCEPT_BACKOFF_MS
+*/
+void    UringBackend::completeFd(const struct io_uring_cqe& cqe, std::vector<IOEvent>& events)
+{
+    int             op = cqe.user_data >> 56;
+    int             fd = (int)(cqe.user_data & 0xFFFFFFFFu);
+    unsigned short  generation = (cqe.user_data >> 32) & 0xFFFF;
+    unsigned char   seq = (cqe.user_data >> 48) & 0xFF;
+    bool            more = cqe.flags & IORING_CQE_F_MORE;
+
+    if (op == URING_OP_CANCEL)
+        return ;
+
+    FdState* st = state(fd);
+    bool    current = (st != NULL && st->generation == generation);
+    IOEvent event;
+    event.fd = fd;
+    event.flags = 0;
+    event.data = NULL;
+    event.length = 0;
+    event.buffer = -1;
+
+    if (op == URING_OP_RECV)
+    {
+        if (cqe.flags & IORING_CQE_F_BUFFER)
+        {
+            int bid = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+            if (!current || cqe.res <= 0)
+                recycleBuffer(bid);
+            else
+            {
+                event.flags = EVENT_DATA;
+                event.data = _buffers + (size_t)bid * URING_BUFFER_SIZE;
+                event.length = cqe.res;
+                event.buffer = bid;
+                events.push_back(event);
+            }
+        }
+        if (!current || more || seq != st->armSeq)
+            return ;
+        st->armed = false;
+        if (cqe.res == 0 || (cqe.res < 0 && cqe.res != -ENOBUFS && cqe.res != -ECANCELED))
+        {
+            event.flags = EVENT_ERROR;
+            events.push_back(event);
+        }
+        else if (!st->paused)
+            armRecv(fd, *st);
+    }
+    else if (op == URING_OP_ACCEPT)
+    {
+        if (cqe.res >= 0 && !current)
+            close(cqe.res);
+        else if (cqe.res >= 0)
+        {
+            event.fd = cqe.res;
+            event.flags = EVENT_ACCEPT;
+            events.push_back(event);
+        }
+        if (!current || more)
+            return ;
+        if (cqe.res < 0)
+            armBackoff(fd, *st);
+        else
+            armAccept(fd, *st);
+    }
+    else if (op == URING_OP_BACKOFF)
+    {
+        if (current && st->role == FD_LISTENER)
+            armAccept(fd, *st);
+    }
+    else if (current)
+    {
+        if (cqe.res > 0)
+        {
+            event.flags = EVENT_READ;
+            events.push_back(event);
+        }
+        if (!more && cqe.res != -ECANCELED)
+            armPoll(fd, *st);
+    }
+}
+
+/*
+** completeSend(const struct io_uring_cqe& cqe, std::vector<IOEvent>& events) [PRIVATE]
+** Unpins the buffers and reports EVENT_SENT (or EVENT_ERROR) for a
+** connection that is still the one the send was made for.
+*/
+void    UringBackend::completeSend(const struct io_uring_cqe& cqe, std::vector<IOEvent>& events)
+{
+    int     index = (int)(cqe.user_data & 0xFFFFFFFFu);
+    SendOp* op = _sendOps[index];
+    FdState* st = state(op->fd);
+
+    for (size_t i = 0; i < op->pinned; i++)
+        op->pins[i] = SharedBuffer();
+    _freeSendOps.push_back(index);
+    if (st == NULL || st->generation != op->generation)
+        return ;
+    st->sendOp = -1;
+
+    IOEvent event;
+    event.fd = op->fd;
+    event.flags = (cqe.res < 0) ? EVENT_ERROR : EVENT_SENT;
+    event.data = NULL;
+    event.length = (cqe.res < 0) ? 0 : cqe.res;
+    event.buffer = -1;
+    events.push_back(event);
+}
+
+bool    UringBackend::completesIO() const
+{
+    return (true);
+}
+
+const char* UringBackend::getName() const
+{
+    return ("io_uring");
+}
+
+#endif
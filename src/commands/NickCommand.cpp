@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   NickCommand.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:12:20 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 16:12:20 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/commands/NickCommand.hpp"
+#include "../../inc/ReplyBuilder.hpp"
+#include <cctype>
+#include <cstring>
+
+NickCommand::NickCommand(NetworkManager& networkManager, UserRegistry& userRegistry,
+    RegistrationBurst& registrationBurst)
+    : _networkManager(networkManager), _userRegistry(userRegistry),
+    _registrationBurst(registrationBurst) {}
+
+bool    NickCommand::requiresAuth() const
+{
+    return (false);
+}
+
+/*
+** isValidNickname(const std::string& nick) [PRIVATE]
+** RFC 2812: ( letter / special ) *( letter / digit / special / "-" ),
+** at most NICKLEN characters.
+*/
+bool    NickCommand::isValidNickname(const std::string& nick)
+{
+    static const char*  special = "[]\\`_^{|}";
+
+    if (nick.empty() || nick.length() > NICKLEN)
+        return (false);
+    for (size_t i = 0; i < nick.length(); i++)
+    {
+        unsigned char c = nick[i];
+
+        if (std::isalpha(c) || std::strchr(special, c) != NULL)
+            continue ;
+        if (i > 0 && (std::isdigit(c) || c == '-'))
+            continue ;
+        return (false);
+    }
+    return (true);
+}
+
+void    NickCommand::execute(Client* client, const IRCMessage& msg)
+{
+    executeView(client, IRCMessageView(msg));
+}
+
+void    NickCommand::executeView(Client* client, const IRCMessageView& msg)
+{
+    if (!client->isPasswordVerified())
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(451, client->getReplyTarget())
+            .trailing("You have not registered").send();
+        return ;
+    }
+
+    const std::string   nick = ((msg.paramCount == 0) ? msg.trailing : msg.params[0]).str();
+    if (nick.empty())
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(431, client->getReplyTarget())
+            .trailing("No nickname given").send();
+        return ;
+    }
+    if (!isValidNickname(nick))
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(432, client->getReplyTarget())
+            .param(nick).trailing("Erroneous nickname").send();
+        return ;
+    }
+    if (nick == client->getNickname())
+        return ;
+    Client* owner = _userRegistry.getClientByNick(nick);
+    if (owner != NULL && owner != client)
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(433, client->getReplyTarget())
+            .param(nick).trailing("Nickname is already in use").send();
+        return ;
+    }
+
+    if (client->getState() == REGISTERED)
+        ReplyBuilder(_networkManager, client->getFd()).source(client->getPrefix())
+            .command("NICK").trailing(nick).send();
+    _userRegistry.updateNickname(client, nick);
+    _registrationBurst.completeRegistration(client, _userRegistry);
+}
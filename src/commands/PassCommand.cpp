@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PassCommand.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:04:51 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 16:04:51 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/commands/PassCommand.hpp"
+#include "../../inc/ReplyBuilder.hpp"
+#include <cstring>
+
+PassCommand::PassCommand(NetworkManager& networkManager, const std::string& password)
+    : _networkManager(networkManager), _password(password) {}
+
+bool    PassCommand::requiresAuth() const
+{
+    return (false);
+}
+
+void    PassCommand::execute(Client* client, const IRCMessage& msg)
+{
+    executeView(client, IRCMessageView(msg));
+}
+
+void    PassCommand::executeView(Client* client, const IRCMessageView& msg)
+{
+    if (client->getState() == REGISTERED)
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(462, client->getReplyTarget())
+            .trailing("You may not reregister").send();
+        return ;
+    }
+
+    const StringSlice&  password = (msg.paramCount == 0) ? msg.trailing : msg.params[0];
+    if (password.empty())
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(461, client->getReplyTarget())
+            .param("PASS").trailing("Not enough parameters").send();
+        return ;
+    }
+    if (password.length != _password.length()
+        || std::memcmp(password.data, _password.data(), password.length) != 0)
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(464, client->getReplyTarget())
+            .trailing("Password incorrect").send();
+        ReplyBuilder(_networkManager, client->getFd()).command("ERROR")
+            .trailing("Closing Link: " + client->getHostname() + " (Password incorrect)").send();
+        _networkManager.removeClient(client->getFd());
+        return ;
+    }
+    client->setPasswordVerified(true);
+    client->setState(AUTHENTICATING);
+}
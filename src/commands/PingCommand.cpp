@@ -0,0 +1,40 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PingCommand.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:41:03 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 20:41:03 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/commands/PingCommand.hpp"
+#include "../../inc/ReplyBuilder.hpp"
+
+PingCommand::PingCommand(NetworkManager& networkManager)
+    : _networkManager(networkManager) {}
+
+bool    PingCommand::requiresAuth() const
+{
+    return (false);
+}
+
+void    PingCommand::execute(Client* client, const IRCMessage& msg)
+{
+    executeView(client, IRCMessageView(msg));
+}
+
+void    PingCommand::executeView(Client* client, const IRCMessageView& msg)
+{
+    const StringSlice&  token = (msg.paramCount == 0) ? msg.trailing : msg.params[0];
+    if (token.empty())
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(409, client->getReplyTarget())
+            .trailing("No origin specified").send();
+        return ;
+    }
+    ReplyBuilder(_networkManager, client->getFd()).source(SERVER_NAME).command("PONG")
+        .param(SERVER_NAME).trailing(token).send();
+}
@@ -0,0 +1,30 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PongCommand.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 20:41:03 by odana             #+#    #+#             */
+/*   Updated: 2026/10/16 20:41:03 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/commands/PongCommand.hpp"
+
+bool    PongCommand::requiresAuth() const
+{
+    return (false);
+}
+
+void    PongCommand::execute(Client* client, const IRCMessage& msg)
+{
+    (void)client;
+    (void)msg;
+}
+
+void    PongCommand::executeView(Client* client, const IRCMessageView& msg)
+{
+    (void)client;
+    (void)msg;
+}
@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StatsCommand.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:15:47 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 19:15:47 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/commands/StatsCommand.hpp"
+#include "../../inc/IRCServer.hpp"
+#include "../../inc/CommandEngine.hpp"
+#include "../../inc/ReplyBuilder.hpp"
+#include <sstream>
+#include <iomanip>
+
+StatsCommand::StatsCommand(NetworkManager& networkManager, IRCServer& server)
+    : _networkManager(networkManager), _server(server) {}
+
+bool    StatsCommand::requiresAuth() const
+{
+    return (true);
+}
+
+void    StatsCommand::execute(Client* client, const IRCMessage& msg)
+{
+    executeView(client, IRCMessageView(msg));
+}
+
+/*
+** executeView(Client* client, const IRCMessageView& msg)
+** The snapshot is taken without any lock: each loop's counters are
+** read as they are (see Metrics). It is big (a histogram per command),
+** so it lives on the heap for the duration of the reply.
+*/
+void    StatsCommand::executeView(Client* client, const IRCMessageView& msg)
+{
+    StringSlice query = (msg.paramCount == 0) ? msg.trailing : msg.params[0];
+    char        letter = query.empty() ? '*' : query.data[0];
+
+    if (letter == 'm' || letter == 'p')
+    {
+        Metrics* metrics = new Metrics();
+        _server.collectMetrics(*metrics);
+        if (letter == 'm')
+            sendCommands(client, *metrics);
+        else
+            sendPerformance(client, *metrics);
+        delete metrics;
+    }
+    else if (letter == 'u')
+        sendUptime(client);
+    ReplyBuilder(_networkManager, client->getFd()).numeric(219, client->getNickname())
+        .param(std::string(1, letter)).trailing("End of STATS report").send();
+}
+
+void    StatsCommand::sendCommands(Client* client, const Metrics& metrics)
+{
+    for (int i = 0; i <= CMD_COUNT; i++)
+    {
+        if (metrics.commands[i] == 0)
+            continue ;
+        std::ostringstream count;
+        count << metrics.commands[i];
+        ReplyBuilder(_networkManager, client->getFd()).numeric(212, client->getNickname())
+            .param(CommandEngine::name((CommandId)i)).param(count.str())
+            .param("0").param("0").send();
+    }
+}
+
+void    StatsCommand::sendUptime(Client* client)
+{
+    unsigned long       uptime = _server.getUptime();
+    std::ostringstream  text;
+
+    text << "Server Up " << uptime / 86400 << " days " << (uptime % 86400) / 3600 << ":"
+        << std::setfill('0') << std::setw(2) << (uptime % 3600) / 60 << ":"
+        << std::setw(2) << uptime % 60;
+    ReplyBuilder(_networkManager, client->getFd()).numeric(242, client->getNickname())
+        .trailing(text.str()).send();
+}
+
+/*
+** formatNs(unsigned long ns) [STATIC]
+** Returns: a duration with a readable unit ("850ns", "12.4us", "3.1ms")
+*/
+static std::string  formatNs(unsigned long ns)
+{
+    std::ostringstream  out;
+
+    out << std::fixed << std::setprecision(1);
+    if (ns < 1000)
+        out << ns << "ns";
+    else if (ns < 1000000)
+        out << ns / 1e3 << "us";
+    else if (ns < 1000000000)
+        out << ns / 1e6 << "ms";
+    else
+        out << ns / 1e9 << "s";
+    return (out.str());
+}
+
+static std::string  formatLatency(const LatencyHistogram& histogram)
+{
+    return ("p50 " + formatNs(histogram.quantile(0.5)) + " p99 "
+        + formatNs(histogram.quantile(0.99)) + " max " + formatNs(histogram.getMax()));
+}
+
+void    StatsCommand::sendPerformance(Client* client, const Metrics& metrics)
+{
+    std::ostringstream  line;
+
+    line << "loop: " << metrics.loopIterations << " iterations, "
+        << formatLatency(metrics.loopTime);
+    sendDebug(client, line.str());
+    line.str("");
+    line << "in: " << metrics.bytesIn << " bytes, " << metrics.linesIn << " lines, "
+        << metrics.parseErrors << " parse errors; out: " << metrics.bytesOut << " bytes";
+    sendDebug(client, line.str());
+    line.str("");
+    line << "connections: " << metrics.connections << " open, "
+        << metrics.connectionsAccepted << " accepted, " << metrics.connectionsClosed
+        << " closed";
+    sendDebug(client, line.str());
+    line.str("");
+    line << "sendq: " << metrics.sendQBytes << " bytes queued, "
+        << metrics.sendDelay.getCount() << " backlogs drained, "
+        << formatLatency(metrics.sendDelay);
+    sendDebug(client, line.str());
+    for (int i = 0; i <= CMD_COUNT; i++)
+    {
+        if (metrics.commandTime[i].getCount() == 0)
+            continue ;
+        line.str("");
+        line << CommandEngine::name((CommandId)i) << ": "
+            << metrics.commandTime[i].getCount() << " runs, "
+            << formatLatency(metrics.commandTime[i]);
+        sendDebug(client, line.str());
+    }
+}
+
+void    StatsCommand::sendDebug(Client* client, const std::string& text)
+{
+    ReplyBuilder(_networkManager, client->getFd()).numeric(249, client->getNickname())
+        .trailing(text).send();
+}
@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UserCommand.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: odana <odana@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:25:03 by odana             #+#    #+#             */
+/*   Updated: 2026/10/17 16:25:03 by odana            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../inc/commands/UserCommand.hpp"
+#include "../../inc/ReplyBuilder.hpp"
+
+UserCommand::UserCommand(NetworkManager& networkManager, UserRegistry& userRegistry,
+    RegistrationBurst& registrationBurst)
+    : _networkManager(networkManager), _userRegistry(userRegistry),
+    _registrationBurst(registrationBurst) {}
+
+bool    UserCommand::requiresAuth() const
+{
+    return (false);
+}
+
+void    UserCommand::execute(Client* client, const IRCMessage& msg)
+{
+    executeView(client, IRCMessageView(msg));
+}
+
+void    UserCommand::executeView(Client* client, const IRCMessageView& msg)
+{
+    if (!client->isPasswordVerified())
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(451, client->getReplyTarget())
+            .trailing("You have not registered").send();
+        return ;
+    }
+    if (client->getState() == REGISTERED || !client->getUsername().empty())
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(462, client->getReplyTarget())
+            .trailing("You may not reregister").send();
+        return ;
+    }
+
+    // the realname is usually the trailing, but may be a 4th middle param
+    size_t  given = msg.paramCount + (msg.trailing.empty() ? 0 : 1);
+    if (given < 4 || msg.params[0].empty())
+    {
+        ReplyBuilder(_networkManager, client->getFd()).numeric(461, client->getReplyTarget())
+            .param("USER").trailing("Not enough parameters").send();
+        return ;
+    }
+
+    client->setUsername(msg.params[0].str());
+    client->setRealname((msg.paramCount > 3 ? msg.params[3] : msg.trailing).str());
+    _registrationBurst.completeRegistration(client, _userRegistry);
+}
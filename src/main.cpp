@@ -26,6 +26,19 @@ int main(int argc, char** argv)
         std::string password = argv[2];
         
         IRCServer server(port, password);
+        // multi-reactor mode: IRCSERV_REACTORS=<n> event loops (default 1)
+        if (std::getenv("IRCSERV_REACTORS") != NULL)
+            server.setReactorCount(std::atoi(std::getenv("IRCSERV_REACTORS")));
+        // event backend: IRCSERV_BACKEND=epoll|poll|uring (default epoll)
+        if (std::getenv("IRCSERV_BACKEND") != NULL)
+            server.setEventBackend(std::getenv("IRCSERV_BACKEND"));
+        // IRCSERV_FLOOD=off disables flood control (load testing only)
+        if (std::getenv("IRCSERV_FLOOD") != NULL
+            && std::string(std::getenv("IRCSERV_FLOOD")) == "off")
+            server.setFloodControl(false);
+        // IRCSERV_METRICS=<path>: metrics scrape endpoint on a unix socket
+        if (std::getenv("IRCSERV_METRICS") != NULL)
+            server.setMetricsSocket(std::getenv("IRCSERV_METRICS"));
         server.initialize();
         server.run();
     }